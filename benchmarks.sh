@@ -16,81 +16,84 @@ PROJECT_NAME="$1"
 PROJECT_DIR="${SCRIPT_DIR}/${PROJECT_NAME}"
 # For nested projects (e.g., containers/vector), use the last component as binary name
 BINARY_NAME=$(basename "${PROJECT_NAME}")
-BUILD_BASE_DIR="${SCRIPT_DIR}/.build"
 # Replace slashes with underscores for directory names
 SAFE_PROJECT_NAME="${PROJECT_NAME//\//_}"
 BENCHMARKS_DIR="${SCRIPT_DIR}/.benchmarks/${SAFE_PROJECT_NAME}"
 BENCHMARK_FILE="${BENCHMARKS_DIR}/benchmark.log"
+# Google Benchmark JSON per configuration and binary: runs/<compiler>_<opt_level>/<binary>.json
+# (runs/<compiler>_<opt_level>/<binary>.rep<k>.json with PERFECTION_REPETITIONS > 1)
+RUNS_DIR="${BENCHMARKS_DIR}/runs"
 
 if [ ! -d "${PROJECT_DIR}" ]; then
     echo "Error: Project directory ${PROJECT_DIR} does not exist"
     exit 1
 fi
 
-COMPILERS=("clang" "gcc")
-OPT_LEVELS=("O0" "O1" "O2" "O3")
+# Multithreaded projects get all PERFECTION_THREADED_CPUS, the others one core
+PROJECT_CPUS=$(project_bench_cpus "${PROJECT_NAME}")
 
 mkdir -p "${BENCHMARKS_DIR}"
 
 > "${BENCHMARK_FILE}"
+rm -rf "${RUNS_DIR}"
 
 echo "============================================"
 echo "Starting benchmark runs for project: ${PROJECT_NAME}"
 echo "Compilers: ${COMPILERS[@]}"
 echo "Optimization levels: ${OPT_LEVELS[@]}"
+echo "Flag profiles: ${PERFECTION_PROFILES:-none}"
+echo "Benchmark CPUs: ${PROJECT_CPUS}"
+echo "Hardware counters: ${PERFECTION_COUNTERS:-disabled}"
+echo "Repetitions: ${PERFECTION_REPETITIONS}"
 echo "============================================"
 echo ""
 
+# Build every configuration up front in parallel (run_all.sh does this itself
+# for all projects and sets PERFECTION_SKIP_BUILD)
+if [ -z "${PERFECTION_SKIP_BUILD}" ]; then
+    build_matrix "${SCRIPT_DIR}" "${PROJECT_NAME}"
+fi
+
+# One job per configuration, binary and repetition. Repetitions are shuffled so slow
+# drift (thermal, frequency, background load) spreads over all configurations instead
+# of biasing whichever ran last.
+JOBS=()
 for compiler in "${COMPILERS[@]}"; do
-    for opt_level in "${OPT_LEVELS[@]}"; do
-        BUILD_DIR="${BUILD_BASE_DIR}/${SAFE_PROJECT_NAME}/${compiler}_${opt_level}"
-        
-        echo "============================================"
-        echo "Building ${PROJECT_NAME} with ${compiler} -${opt_level}..."
-        echo "Build dir: ${BUILD_DIR}"
-        echo "============================================"
-        
-        build_project "${PROJECT_DIR}" "${BUILD_DIR}" "${compiler}" "${opt_level}"
-        
-        echo ""
-        echo "============================================"
-        echo "Running benchmarks with ${compiler} -${opt_level}..."
-        echo "============================================"
-        
-        echo "========== ${compiler} -${opt_level} ==========" >> "${BENCHMARK_FILE}"
-        
-        # Check if we have multiple bench_* binaries (new structure)
-        BENCH_BINARIES=$(find "${BUILD_DIR}" -maxdepth 1 -name "bench_*" -type f 2>/dev/null || true)
-        
-        if [ -n "${BENCH_BINARIES}" ]; then
-            # Multiple binaries - run each one
-            for bench_binary in ${BENCH_BINARIES}; do
-                BENCH_NAME=$(basename "${bench_binary}")
-                echo "--- ${BENCH_NAME} ---" >> "${BENCHMARK_FILE}"
-                "${bench_binary}" 2>&1 | grep -E "^(Benchmark|[A-Z][A-Za-z]+/|---)" >> "${BENCHMARK_FILE}"
-                echo "" >> "${BENCHMARK_FILE}"
+    for opt_level in $(config_opt_levels "${compiler}"); do
+        BUILD_DIR=$(config_build_dir "${SCRIPT_DIR}" "${PROJECT_NAME}" "${compiler}" "${opt_level}")
+        for bench_binary in $(config_binaries "${BUILD_DIR}" "${BINARY_NAME}"); do
+            for rep in $(seq 1 "${PERFECTION_REPETITIONS}"); do
+                JOBS+=("${compiler}:${opt_level}:${bench_binary}:${rep}")
             done
-        else
-            # Single binary (fallback to old behavior)
-            "${BUILD_DIR}/${BINARY_NAME}" 2>&1 | grep -E "^(Benchmark|BM_|---)" >> "${BENCHMARK_FILE}"
-        fi
-        
-        echo "" >> "${BENCHMARK_FILE}"
-        
-        echo ""
+        done
     done
 done
+if [ "${PERFECTION_REPETITIONS}" -gt 1 ]; then
+    mapfile -t JOBS < <(printf '%s\n' "${JOBS[@]}" | shuf)
+fi
+
+# Run serially on the pinned core(s) so concurrent work does not disturb measurements
+for job in "${JOBS[@]}"; do
+    IFS=: read -r compiler opt_level bench_binary rep <<< "${job}"
+    run_benchmark "${SCRIPT_DIR}" "${PROJECT_NAME}" "${compiler}" "${opt_level}" "${bench_binary}" "${rep}"
+    echo ""
+done
+
+# Refresh the merged results store (.benchmarks/results.json) with this project's runs
+python3 "${SCRIPT_DIR}/perfection_results.py" merge "${SCRIPT_DIR}/.benchmarks"
 
 echo "============================================"
-echo "Done! Results saved to: ${BENCHMARK_FILE}"
+echo "Done! Results saved to: ${RUNS_DIR}/"
+echo "Console log: ${BENCHMARK_FILE}"
 echo "============================================"
 echo ""
 echo "To view results:"
-echo "  cat ${BENCHMARK_FILE}"
+echo "  python3 ${SCRIPT_DIR}/generate_summary.py ${BENCHMARKS_DIR}"
+echo "  cat ${BENCHMARKS_DIR}/summary.md"
 echo ""
 echo "Summary of test configurations:"
 for compiler in "${COMPILERS[@]}"; do
-    for opt_level in "${OPT_LEVELS[@]}"; do
+    for opt_level in $(config_opt_levels "${compiler}"); do
         echo "  - ${compiler} -${opt_level}"
     done
 done
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""
+Crossover curve of branchy vs branchless swaps from the taken-probability sweep.
+
+Reads Sweep/<Variant>/<percent> from .benchmarks/results.json and, per configuration, puts
+the variants side by side (ns per pair) for every probability from 0% to 100%:
+
+    | Taken | Branchy | Mask | Cmov | Blend_AVX2 | Mask_AVX512 |
+    |-------|---------|------|------|------------|-------------|
+    |    0% |    0.85 | 0.52 | 0.55 |       0.53 |        0.54 |
+    ...
+
+followed by the probability ranges where each branchless variant beats Branchy: outside
+them the branch predictor makes the branchy code cheaper. Each range is a contiguous run of
+measured probabilities; noisy points near the crossover can split the wins into several runs.
+Output: .benchmarks/branch_prediction/branchless_crossover.md
+
+Usage:
+    python3 branch_prediction/branchless_crossover.py [results.json]
+"""
+
+import sys
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+ROOT_DIR = Path(__file__).resolve().parent.parent
+sys.path.insert(0, str(ROOT_DIR))
+
+from generate_summary import order_config_names, project_report_main  # noqa: E402
+from perfection_results import measured_time_ns, median  # noqa: E402
+
+
+PROJECT = "branch_prediction"
+
+# Pairs per sweep iteration (ARRAY_SIZE / 2 in branch_prediction/main.cpp)
+PAIRS = 512 * 1024
+
+BASELINE = "Branchy"
+
+VARIANT_ORDER = ['Branchy', 'Mask', 'Cmov', 'Blend_AVX2', 'Mask_AVX512']
+
+
+def sweep(records: List[Dict]) -> Dict[str, Dict[str, Dict[int, float]]]:
+    """
+    Median ns per pair for each config, variant and taken percentage.
+    
+    Returns: {'gcc_O3': {'Branchy': {0: 0.85, 5: 1.2, ...}, 'Mask': {...}}}
+    """
+    samples = {}
+    for record in records:
+        parts = record['benchmark'].split('/')
+        if len(parts) != 3 or parts[0] != 'Sweep' or not parts[2].isdigit():
+            continue
+        variant, percent = parts[1], int(parts[2])
+        samples.setdefault(record['config'], {}).setdefault(variant, {}).setdefault(percent, []).append(
+            measured_time_ns(record) / PAIRS)
+    return {config: {variant: {percent: median(values) for percent, values in points.items()}
+                     for variant, points in variants.items()}
+            for config, variants in samples.items()}
+
+
+def winning_ranges(baseline: Dict[int, float], variant: Dict[int, float]) -> List[Tuple[int, int]]:
+    """
+    Contiguous runs of measured percentages where the variant is faster than the baseline.
+    
+    Input: baseline {0: 0.8, 25: 3.0, 50: 5.0, 75: 0.9, 100: 0.8},
+           variant  {0: 1.0, 25: 1.0, 50: 1.0, 75: 1.0, 100: 0.7}
+    Output: [(25, 50), (100, 100)]; [] if the variant never wins
+    """
+    runs = []
+    start = previous = None
+    for percent in sorted(percent for percent in variant if percent in baseline):
+        if variant[percent] < baseline[percent]:
+            if start is None:
+                start = percent
+            previous = percent
+        elif start is not None:
+            runs.append((start, previous))
+            start = None
+    if start is not None:
+        runs.append((start, previous))
+    return runs
+
+
+def generate_report(records: List[Dict]) -> str:
+    """Markdown report: curve table and winning ranges per configuration."""
+    results = sweep(records)
+    
+    md = "# Branchless Crossover\n\n"
+    if not results:
+        return md + "No Sweep/ results found (run: ./benchmarks.sh branch_prediction).\n"
+    md += "ns per pair; `*` marks the fastest variant at each probability.\n\n"
+    
+    for config in order_config_names(results):
+        curves = results[config]
+        variants = sorted(curves, key=lambda v: (VARIANT_ORDER.index(v) if v in VARIANT_ORDER else len(VARIANT_ORDER), v))
+        percents = sorted({percent for points in curves.values() for percent in points})
+        
+        md += f"## {config}\n\n"
+        md += "| Taken | " + " | ".join(variants) + " |\n"
+        md += "|-------|" + "|".join("-" * (len(variant) + 2) for variant in variants) + "|\n"
+        for percent in percents:
+            times = {variant: curves[variant][percent] for variant in variants if percent in curves[variant]}
+            fastest = min(times, key=times.get)
+            cells = []
+            for variant in variants:
+                if variant not in times:
+                    cells.append(f"{'-':>{len(variant)}}")
+                    continue
+                mark = "*" if variant == fastest else " "
+                cells.append(f"{times[variant]:.2f}{mark}".rjust(len(variant)))
+            md += f"| {percent:4d}% | " + " | ".join(cells) + " |\n"
+        md += "\n"
+        
+        if BASELINE in curves:
+            for variant in variants:
+                if variant == BASELINE:
+                    continue
+                runs = winning_ranges(curves[BASELINE], curves[variant])
+                if not runs:
+                    md += f"- {variant}: never faster than {BASELINE}\n"
+                else:
+                    spans = ", ".join(f"{low}%" if low == high else f"{low}% to {high}%" for low, high in runs)
+                    md += f"- {variant}: faster than {BASELINE} at {spans} taken\n"
+            md += "\n"
+    return md
+
+
+def main():
+    project_report_main(PROJECT, "branchless_crossover.md", generate_report)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,6 +1,11 @@
+#include <algorithm>
 #include <random>
+#include <string>
 #include <benchmark/benchmark.h>
 
+// Isa, cpu_supports(), PERFECTION_X86 and <immintrin.h>
+#include "../common/isa.h"
+
 // Array of random numbers from 1 to 100
 static constexpr size_t ARRAY_SIZE = 1024 * 1024; // 1M elements
 static int data[ARRAY_SIZE];
@@ -115,6 +120,239 @@ void prfct_swap_unpredictable_unlikely() {
     }
 }
 
+// ========== BRANCHLESS VARIANTS ==========
+// The same two passes as prfct_swap_predictable / prfct_swap_unpredictable with the
+// thresholds as arguments: pass 1 swaps when sum < below, pass 2 when sum > above
+// (predictable: 195 / 195, unpredictable: 100 / 99). Swapping keeps the sum, so every
+// iteration sees the same outcomes. prfct_swap_branchy is the branchy reference with
+// the same runtime thresholds. At -O3 the compilers may vectorize the scalar
+// branchless versions; -O1/-O2 show them as scalar code (and/xor or cmov).
+
+using ThresholdKernel = void (*)(int below, int above);
+
+void prfct_swap_branchy(int below, int above) {
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        if (data[i] + data[ARRAY_SIZE - 1 - i] < below) {
+            std::swap(data[i], data[ARRAY_SIZE - 1 - i]);
+        }
+    }
+    
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        if (data[i] + data[ARRAY_SIZE - 1 - i] > above) {
+            std::swap(data[i], data[ARRAY_SIZE - 1 - i]);
+        }
+    }
+}
+
+// Arithmetic mask: all ones when the condition holds, xor-swap through it
+inline void swap_if_mask(int& a, int& b, bool condition) {
+    int mask = -static_cast<int>(condition);
+    int diff = (a ^ b) & mask;
+    a ^= diff;
+    b ^= diff;
+}
+
+void prfct_swap_mask(int below, int above) {
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        int& a = data[i];
+        int& b = data[ARRAY_SIZE - 1 - i];
+        swap_if_mask(a, b, a + b < below);
+    }
+    
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        int& a = data[i];
+        int& b = data[ARRAY_SIZE - 1 - i];
+        swap_if_mask(a, b, a + b > above);
+    }
+}
+
+// Ternary select: unconditional stores of selected values (cmov in scalar code)
+inline void swap_if_select(int& a, int& b, bool condition) {
+    int x = a;
+    int y = b;
+    a = condition ? y : x;
+    b = condition ? x : y;
+}
+
+void prfct_swap_cmov(int below, int above) {
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        int& a = data[i];
+        int& b = data[ARRAY_SIZE - 1 - i];
+        swap_if_select(a, b, a + b < below);
+    }
+    
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        int& a = data[i];
+        int& b = data[ARRAY_SIZE - 1 - i];
+        swap_if_select(a, b, a + b > above);
+    }
+}
+
+// ========== SIMD BLEND / PREDICATION ==========
+// Explicit vector versions (dispatch: common/isa.h): AVX2 compares into a lane mask
+// and blends (vpblendvb), AVX-512 compares into a mask register and predicates the
+// blend (vpblendmd)
+
+#ifdef PERFECTION_X86
+// 8 pairs per step: the back vector is reversed so lane k holds the partner of front lane k
+__attribute__((target("avx2")))
+void prfct_swap_blend_avx2(int below, int above) {
+    constexpr size_t W = 8;
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i below_v = _mm256_set1_epi32(below);
+    const __m256i above_v = _mm256_set1_epi32(above);
+    
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+            int* front = data + i;
+            int* back = data + ARRAY_SIZE - i - W;
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(front));
+            __m256i b = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(back)), reverse);
+            __m256i sum = _mm256_add_epi32(a, b);
+            __m256i swap = pass == 0 ? _mm256_cmpgt_epi32(below_v, sum) : _mm256_cmpgt_epi32(sum, above_v);
+            __m256i new_a = _mm256_blendv_epi8(a, b, swap);
+            __m256i new_b = _mm256_blendv_epi8(b, a, swap);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(front), new_a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(back), _mm256_permutevar8x32_epi32(new_b, reverse));
+        }
+    }
+}
+
+// 16 pairs per step, the comparison yields a mask register that predicates the blend
+__attribute__((target("avx512f")))
+void prfct_swap_mask_avx512(int below, int above) {
+    constexpr size_t W = 16;
+    const __m512i reverse = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i below_v = _mm512_set1_epi32(below);
+    const __m512i above_v = _mm512_set1_epi32(above);
+    
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+            int* front = data + i;
+            int* back = data + ARRAY_SIZE - i - W;
+            __m512i a = _mm512_loadu_si512(front);
+            __m512i b = _mm512_permutexvar_epi32(reverse, _mm512_loadu_si512(back));
+            __m512i sum = _mm512_add_epi32(a, b);
+            __mmask16 swap = pass == 0 ? _mm512_cmplt_epi32_mask(sum, below_v) : _mm512_cmpgt_epi32_mask(sum, above_v);
+            _mm512_storeu_si512(front, _mm512_mask_blend_epi32(swap, a, b));
+            _mm512_storeu_si512(back, _mm512_permutexvar_epi32(reverse, _mm512_mask_blend_epi32(swap, b, a)));
+        }
+    }
+}
+#endif
+
+// ========== COMPARE-EXCHANGE: std::min / std::max ==========
+// Where the swap condition is an ordering (a > b), the swap is min/max. Pass 1 orders
+// each pair ascending (~50% swaps on random data), pass 2 descending (almost all swap),
+// so the data never settles.
+
+void prfct_sort_pairs_branchy() {
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        if (data[i] > data[ARRAY_SIZE - 1 - i]) {
+            std::swap(data[i], data[ARRAY_SIZE - 1 - i]);
+        }
+    }
+    
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        if (data[i] < data[ARRAY_SIZE - 1 - i]) {
+            std::swap(data[i], data[ARRAY_SIZE - 1 - i]);
+        }
+    }
+}
+
+void prfct_sort_pairs_minmax() {
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        int a = data[i];
+        int b = data[ARRAY_SIZE - 1 - i];
+        data[i] = std::min(a, b);
+        data[ARRAY_SIZE - 1 - i] = std::max(a, b);
+    }
+    
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        int a = data[i];
+        int b = data[ARRAY_SIZE - 1 - i];
+        data[i] = std::max(a, b);
+        data[ARRAY_SIZE - 1 - i] = std::min(a, b);
+    }
+}
+
+// ========== TAKEN-PROBABILITY SWEEP ==========
+// The swap of pair i is decided by a separate key (keys[i] < percent), so swapping
+// never changes the outcomes. Keys are 0..99 in equal numbers, shuffled: exactly
+// <percent>% of the pairs swap, in random order. Branchy code is cheap near 0% and
+// 100% and pays a misprediction for a growing share of pairs towards 50%; branchless
+// code costs the same at every probability.
+
+static int keys[ARRAY_SIZE / 2];
+
+// Taken probabilities: 0% to 100% in 5% steps
+static constexpr int SWEEP_STEP = 5;
+
+void initialize_keys() {
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        keys[i] = static_cast<int>(i % 100);
+    }
+    std::mt19937 gen(42);
+    std::shuffle(keys, keys + ARRAY_SIZE / 2, gen);
+}
+
+using SweepKernel = void (*)(int percent);
+
+void prfct_sweep_branchy(int percent) {
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        if (keys[i] < percent) {
+            std::swap(data[i], data[ARRAY_SIZE - 1 - i]);
+        }
+    }
+}
+
+void prfct_sweep_mask(int percent) {
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        swap_if_mask(data[i], data[ARRAY_SIZE - 1 - i], keys[i] < percent);
+    }
+}
+
+void prfct_sweep_cmov(int percent) {
+    for (size_t i = 0; i < ARRAY_SIZE / 2; ++i) {
+        swap_if_select(data[i], data[ARRAY_SIZE - 1 - i], keys[i] < percent);
+    }
+}
+
+#ifdef PERFECTION_X86
+__attribute__((target("avx2")))
+void prfct_sweep_blend_avx2(int percent) {
+    constexpr size_t W = 8;
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i percent_v = _mm256_set1_epi32(percent);
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(front));
+        __m256i b = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(back)), reverse);
+        __m256i swap = _mm256_cmpgt_epi32(percent_v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(front), _mm256_blendv_epi8(a, b, swap));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(back),
+                            _mm256_permutevar8x32_epi32(_mm256_blendv_epi8(b, a, swap), reverse));
+    }
+}
+
+__attribute__((target("avx512f")))
+void prfct_sweep_mask_avx512(int percent) {
+    constexpr size_t W = 16;
+    const __m512i reverse = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i percent_v = _mm512_set1_epi32(percent);
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        __m512i a = _mm512_loadu_si512(front);
+        __m512i b = _mm512_permutexvar_epi32(reverse, _mm512_loadu_si512(back));
+        __mmask16 swap = _mm512_cmplt_epi32_mask(_mm512_loadu_si512(keys + i), percent_v);
+        _mm512_storeu_si512(front, _mm512_mask_blend_epi32(swap, a, b));
+        _mm512_storeu_si512(back, _mm512_permutexvar_epi32(reverse, _mm512_mask_blend_epi32(swap, b, a)));
+    }
+}
+#endif
+
 // ========== BENCHMARKS ==========
 
 static void BM_predictable_baseline(benchmark::State& state) {
@@ -177,4 +415,81 @@ BENCHMARK(BM_predictable_unlikely_wrong);
 BENCHMARK(BM_unpredictable_likely_wrong);
 BENCHMARK(BM_unpredictable_unlikely_wrong);
 
+// Branchless variants of the threshold kernels; SIMD kernels are skipped (reported as
+// an error) when the CPU lacks the instruction set
+static void BM_threshold(benchmark::State& state, ThresholdKernel kernel, int below, int above, Isa isa) {
+    if (!cpu_supports(isa)) {
+        state.SkipWithError("instruction set not supported by this CPU");
+    }
+    initialize_data();
+    for (auto _ : state) {
+        kernel(below, above);
+        benchmark::DoNotOptimize(data);
+    }
+}
+
+static void BM_sort_pairs(benchmark::State& state, void (*kernel)()) {
+    initialize_data();
+    for (auto _ : state) {
+        kernel();
+        benchmark::DoNotOptimize(data);
+    }
+}
+
+// items_per_second: pairs per second
+static void BM_sweep(benchmark::State& state, SweepKernel kernel, int percent, Isa isa) {
+    if (!cpu_supports(isa)) {
+        state.SkipWithError("instruction set not supported by this CPU");
+    }
+    initialize_data();
+    initialize_keys();
+    for (auto _ : state) {
+        kernel(percent);
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(ARRAY_SIZE / 2));
+}
+
+struct Variant {
+    const char* name;
+    ThresholdKernel threshold;
+    SweepKernel sweep;
+    Isa isa;
+};
+
+static const Variant VARIANTS[] = {
+    {"Branchy", prfct_swap_branchy, prfct_sweep_branchy, Isa::Native},
+    {"Mask", prfct_swap_mask, prfct_sweep_mask, Isa::Native},
+    {"Cmov", prfct_swap_cmov, prfct_sweep_cmov, Isa::Native},
+#ifdef PERFECTION_X86
+    {"Blend_AVX2", prfct_swap_blend_avx2, prfct_sweep_blend_avx2, Isa::AVX2},
+    {"Mask_AVX512", prfct_swap_mask_avx512, prfct_sweep_mask_avx512, Isa::AVX512},
+#endif
+};
+
+// Names: Threshold/<Predictable|Unpredictable>/<Variant>, CompareExchange/Random/<Variant>,
+// Sweep/<Variant>/<percent> (one summary table per variant, rows sorted by probability;
+// branch_prediction/branchless_crossover.py puts the variants side by side)
+static bool register_branchless() {
+    for (const Variant& variant : VARIANTS) {
+        std::string name = variant.name;
+        benchmark::RegisterBenchmark(("Threshold/Predictable/" + name).c_str(), BM_threshold,
+                                     variant.threshold, 195, 195, variant.isa);
+        benchmark::RegisterBenchmark(("Threshold/Unpredictable/" + name).c_str(), BM_threshold,
+                                     variant.threshold, 100, 99, variant.isa);
+    }
+    benchmark::RegisterBenchmark("CompareExchange/Random/Branchy", BM_sort_pairs, prfct_sort_pairs_branchy);
+    benchmark::RegisterBenchmark("CompareExchange/Random/MinMax", BM_sort_pairs, prfct_sort_pairs_minmax);
+    
+    for (const Variant& variant : VARIANTS) {
+        for (int percent = 0; percent <= 100; percent += SWEEP_STEP) {
+            std::string name = "Sweep/" + std::string(variant.name) + "/" + std::to_string(percent);
+            benchmark::RegisterBenchmark(name.c_str(), BM_sweep, variant.sweep, percent, variant.isa);
+        }
+    }
+    return true;
+}
+
+static const bool registered = register_branchless();
+
 BENCHMARK_MAIN();
@@ -1,53 +1,453 @@
 #!/bin/bash
 
 # Common build functions for Perfection framework
-# This file is sourced by benchmarks.sh and disassembly.sh
+# This file is sourced by benchmarks.sh, disassembly.sh and run_all.sh
 
 set -e
 
+# Repository root (this file's directory), also when sourced from isolated_builds/
+PERFECTION_ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd -P)"
+
+# Default build matrix
+COMPILERS=("clang" "gcc")
+OPT_LEVELS=("O0" "O1" "O2" "O3")
+
+# Number of configurations built concurrently (defaults to all cores)
+PERFECTION_JOBS="${PERFECTION_JOBS:-$(nproc)}"
+
+# Core benchmarks are pinned to (defaults to the last core).
+# For clean measurements isolate it from the scheduler, e.g. boot with isolcpus=<cpu>.
+PERFECTION_BENCH_CPU="${PERFECTION_BENCH_CPU:-$(( $(nproc) - 1 ))}"
+
+# Projects whose benchmarks spawn threads (->Threads()) run on PERFECTION_THREADED_CPUS
+# instead of the single benchmark core (a taskset list, defaults to all cores).
+# <project>/<binary> entries select a single binary of a split suite.
+THREADED_PROJECTS=("memory_bandwidth" "containers/vector/bench_allocator" "exception/exception_threads")
+PERFECTION_THREADED_CPUS="${PERFECTION_THREADED_CPUS:-0-$(( $(nproc) - 1 ))}"
+
+# Hardware performance counters attached to every benchmark result (libpfm event names)
+# Unset: disabled; "1": PERFECTION_DEFAULT_COUNTERS; otherwise a comma-separated event list.
+# Counters may require: sysctl kernel.perf_event_paranoid=1 (or lower)
+PERFECTION_COUNTERS="${PERFECTION_COUNTERS:-}"
+PERFECTION_DEFAULT_COUNTERS="CYCLES,INSTRUCTIONS,BRANCH-MISSES,CACHE-MISSES"
+
+# Times every benchmark binary is run; runs are shuffled across configurations and
+# generate_summary.py reports the median with a 95% confidence interval
+PERFECTION_REPETITIONS="${PERFECTION_REPETITIONS:-1}"
+
+# Compile flag profiles (flag_profiles.conf) built in addition to the plain opt levels,
+# space-separated, e.g. "v3 v3_lto"; each adds configurations named <compiler>_<opt>_<profile>
+PERFECTION_PROFILES="${PERFECTION_PROFILES:-}"
+PROFILES_FILE="${PERFECTION_ROOT}/flag_profiles.conf"
+
+# Set to rebuild configurations whose build key is unchanged
+PERFECTION_REBUILD="${PERFECTION_REBUILD:-}"
+
+# Build key of the last successful build, stored in each configuration's build directory
+BUILD_KEY_FILE=".perfection_build_key"
+
+# Print the flags of a profile for one compiler (see flag_profiles.conf)
+# Fails if the profile has no line for the compiler
+# Usage: profile_flags <compiler> <profile>
+profile_flags() {
+    local compiler="$1"
+    local profile="$2"
+
+    local name target line flags="" found=1
+    while IFS='|' read -r name target line; do
+        [ "${name}" = "${profile}" ] || continue
+        if [ "${target}" = "${compiler}" ]; then
+            echo "${line}"
+            return 0
+        elif [ "${target}" = "*" ]; then
+            flags="${line}"
+            found=0
+        fi
+    done < <(grep -v '^[[:space:]]*\(#\|$\)' "${PROFILES_FILE}" 2>/dev/null)
+
+    [ ${found} -eq 0 ] && echo "${flags}"
+    return ${found}
+}
+
+# Print the opt levels of one compiler's configurations, one per line: every OPT_LEVELS
+# entry, then <opt>_<profile> for each PERFECTION_PROFILES entry defined for the compiler.
+# Configurations are named <compiler>_<opt level>, e.g. gcc_O3 or gcc_O3_v3_lto.
+# Usage: config_opt_levels <compiler>
+config_opt_levels() {
+    local compiler="$1"
+
+    local opt_level profile
+    for opt_level in "${OPT_LEVELS[@]}"; do
+        echo "${opt_level}"
+    done
+    for profile in ${PERFECTION_PROFILES}; do
+        profile_flags "${compiler}" "${profile}" > /dev/null || continue
+        for opt_level in "${OPT_LEVELS[@]}"; do
+            echo "${opt_level}_${profile}"
+        done
+    done
+}
+
+# Split a configuration opt level into the -O level and the flag profile
+# Usage: read -r opt profile <<< "$(split_opt_level O3_v3_lto)"   # -> O3 v3_lto
+split_opt_level() {
+    local opt_level="$1"
+    local profile="${opt_level#*_}"
+    [ "${profile}" = "${opt_level}" ] && profile=""
+    echo "${opt_level%%_*} ${profile}"
+}
+
+# Print the extra compile flags of a configuration opt level (empty without profile)
+# Usage: opt_level_flags <compiler> <opt_level>
+opt_level_flags() {
+    local compiler="$1"
+    local opt profile
+    read -r opt profile <<< "$(split_opt_level "$2")"
+    if [ -n "${profile}" ]; then
+        profile_flags "${compiler}" "${profile}"
+    fi
+}
+
 # Build a project with specific compiler and optimization level
-# Usage: build_project <project_dir> <build_dir> <compiler> <opt_level>
+# Usage: build_project <project_dir> <build_dir> <compiler> <opt_level> [extra_flags]
+# <opt_level> may carry a flag profile (O3_v3_lto); its flags and [extra_flags]
+# (e.g. the PGO flags of pgo.sh) are passed as PERFECTION_EXTRA_FLAGS
 build_project() {
     local project_dir="$1"
     local build_dir="$2"
     local compiler="$3"
-    local opt_level="$4"
-    
+    local opt profile
+    read -r opt profile <<< "$(split_opt_level "$4")"
+    local extra_flags
+    extra_flags=$(echo $(opt_level_flags "${compiler}" "$4") ${5:-})
+
     cmake -S "${project_dir}" -B "${build_dir}" \
         -DCOMPILER_CHOICE="${compiler}" \
-        -DOPTIMIZATION_LEVEL="${opt_level}"
+        -DOPTIMIZATION_LEVEL="${opt}" \
+        -DPERFECTION_EXTRA_FLAGS="${extra_flags}" \
+        -DPERFECTION_ENABLE_LIBPFM="$([ -n "${PERFECTION_COUNTERS}" ] && echo ON || echo OFF)" &&
     cmake --build "${build_dir}"
 }
 
-# Build all configurations for a project
-# Usage: build_all_configurations <project_name> <script_dir> [compilers] [opt_levels]
-build_all_configurations() {
-    local project_name="$1"
-    local script_dir="$2"
-    local compilers=("${3:-clang}" "${4:-gcc}")
-    local opt_levels=("${5:-O0}" "${6:-O1}" "${7:-O2}" "${8:-O3}")
-    
-    # If compilers and opt_levels are not provided, use defaults
-    if [ $# -lt 3 ]; then
-        compilers=("clang" "gcc")
-        opt_levels=("O0" "O1" "O2" "O3")
-    fi
-    
-    local project_dir="${script_dir}/${project_name}"
-    local build_base_dir="${script_dir}/.build"
-    
-    for compiler in "${compilers[@]}"; do
-        for opt_level in "${opt_levels[@]}"; do
-            local build_dir="${build_base_dir}/${project_name}/${compiler}_${opt_level}"
-            
-            echo "============================================"
-            echo "Building ${project_name} with ${compiler} -${opt_level}..."
-            echo "Build dir: ${build_dir}"
-            echo "============================================"
-            
-            build_project "${project_dir}" "${build_dir}" "${compiler}" "${opt_level}"
-            
-            echo ""
+# Build directory of one configuration
+# Nested projects (e.g., containers/vector) use underscores instead of slashes
+# Usage: config_build_dir <script_dir> <project_name> <compiler> <opt_level>
+config_build_dir() {
+    local script_dir="$1"
+    local project_name="$2"
+    local compiler="$3"
+    local opt_level="$4"
+
+    echo "${script_dir}/.build/${project_name//\//_}/${compiler}_${opt_level}"
+}
+
+# Print the benchmark binaries of one built configuration, one path per line:
+# the binaries listed in <build_dir>/perfection_benchmarks.txt (written by perfection_add_benchmark),
+# or for builds without a manifest every bench_* binary or the single <binary_name>
+# Usage: config_binaries <build_dir> <binary_name>
+config_binaries() {
+    local build_dir="$1"
+    local binary_name="$2"
+
+    local manifest="${build_dir}/perfection_benchmarks.txt"
+    if [ -f "${manifest}" ]; then
+        local name
+        while IFS= read -r name; do
+            [ -n "${name}" ] && echo "${build_dir}/${name}"
+        done < "${manifest}"
+        return 0
+    fi
+
+    local bench_binaries
+    bench_binaries=$(find "${build_dir}" -maxdepth 1 -name "bench_*" -type f 2>/dev/null | sort || true)
+    if [ -n "${bench_binaries}" ]; then
+        echo "${bench_binaries}"
+    else
+        echo "${build_dir}/${binary_name}"
+    fi
+}
+
+# Print the source files a project build depends on: sources and CMake files of the
+# project directory plus files reached through quoted includes outside of it
+# (e.g. #include "../containers/vector/common.h")
+# Usage: project_sources <project_dir>
+project_sources() {
+    local project_dir="$1"
+
+    local -A seen=()
+    local queue=()
+    local file
+    while IFS= read -r file; do
+        queue+=("${file}")
+    done < <(find "$(realpath "${project_dir}")" -type d \( -name ".*" -o -name "build*" \) -prune -o -type f \
+        \( -name "*.cpp" -o -name "*.cc" -o -name "*.h" -o -name "*.hpp" -o -name "CMakeLists.txt" -o -name "*.cmake" \) \
+        -print)
+
+    local include resolved
+    while [ ${#queue[@]} -gt 0 ]; do
+        file="${queue[0]}"
+        queue=("${queue[@]:1}")
+        [ -n "${seen[${file}]}" ] && continue
+        seen[${file}]=1
+        while IFS= read -r include; do
+            resolved=$(realpath -q "$(dirname "${file}")/${include}" || true)
+            if [ -f "${resolved}" ] && [ -z "${seen[${resolved}]}" ]; then
+                queue+=("${resolved}")
+            fi
+        done < <(sed -n 's/^[[:space:]]*#[[:space:]]*include[[:space:]]*"\([^"]*\)".*/\1/p' "${file}")
+    done
+
+    printf '%s\n' "${!seen[@]}" | sort
+}
+
+# Print the identity of a compiler: resolved path and version banner
+# Usage: compiler_identity <gcc|clang>
+compiler_identity() {
+    local cxx
+    case "$1" in
+        gcc) cxx="g++" ;;
+        clang) cxx="clang++" ;;
+        *) cxx="$1" ;;
+    esac
+    command -v "${cxx}" || true
+    "${cxx}" --version 2>/dev/null | head -1 || true
+}
+
+# Print the content hash identifying one build: project sources, the common CMake
+# configuration, the toolchain identity and the flags. Identical keys build identical binaries.
+# Usage: build_key <project_dir> <toolchain_identity> [flags...]
+build_key() {
+    local project_dir="$1"
+    shift
+
+    {
+        printf '%s\n' "$@"
+        sha256sum < "${PERFECTION_ROOT}/cmake/PerfectionCommon.cmake"
+        local file
+        project_sources "${project_dir}" | while IFS= read -r file; do
+            echo "${file#"${PERFECTION_ROOT}"/}"
+            sha256sum < "${file}"
         done
+    } | sha256sum | cut -d' ' -f1
+}
+
+# Succeed if <build_dir> holds a successful build with this key and its binaries exist
+# Usage: build_is_cached <build_dir> <key> <binary>...
+build_is_cached() {
+    local build_dir="$1"
+    local key="$2"
+    shift 2
+
+    [ -z "${PERFECTION_REBUILD}" ] || return 1
+    [ "$(cat "${build_dir}/${BUILD_KEY_FILE}" 2>/dev/null)" = "${key}" ] || return 1
+    local binary
+    for binary in "$@"; do
+        [ -x "${binary}" ] || return 1
+    done
+}
+
+# Build one configuration, sending compiler output to <build_dir>/build.log
+# Skipped when its build key matches the last successful build (see build_key)
+# Usage: build_configuration <script_dir> <project_name> <compiler> <opt_level>
+build_configuration() {
+    local script_dir="$1"
+    local project_name="$2"
+    local compiler="$3"
+    local opt_level="$4"
+    local build_dir
+    build_dir=$(config_build_dir "${script_dir}" "${project_name}" "${compiler}" "${opt_level}")
+
+    local libpfm
+    libpfm=$([ -n "${PERFECTION_COUNTERS}" ] && echo ON || echo OFF)
+    local key
+    key=$(build_key "${script_dir}/${project_name}" "$(compiler_identity "${compiler}")" \
+        "-${opt_level}" "flags=$(opt_level_flags "${compiler}" "${opt_level}")" "libpfm=${libpfm}")
+    local binaries
+    mapfile -t binaries < <(config_binaries "${build_dir}" "$(basename "${project_name}")")
+    if build_is_cached "${build_dir}" "${key}" "${binaries[@]}"; then
+        echo "  = ${project_name} ${compiler} -${opt_level} (unchanged)"
+        return 0
+    fi
+
+    mkdir -p "${build_dir}"
+    rm -f "${build_dir}/${BUILD_KEY_FILE}"
+    if build_project "${script_dir}/${project_name}" "${build_dir}" "${compiler}" "${opt_level}" \
+            > "${build_dir}/build.log" 2>&1; then
+        echo "${key}" > "${build_dir}/${BUILD_KEY_FILE}"
+        echo "  ✓ ${project_name} ${compiler} -${opt_level}"
+    else
+        echo "  ✗ ${project_name} ${compiler} -${opt_level} (see ${build_dir}/build.log)"
+        return 1
+    fi
+}
+
+# Build all configurations (COMPILERS × OPT_LEVELS × profiles) of one or more projects in parallel
+# Up to PERFECTION_JOBS configurations are built at once. The first configuration
+# is built alone so it can bootstrap 3rdparty/ without racing other configure steps.
+# Usage: build_matrix <script_dir> <project_name>...
+build_matrix() {
+    local script_dir="$1"
+    shift
+
+    local jobs=()
+    local project_name compiler opt_level
+    for project_name in "$@"; do
+        for compiler in "${COMPILERS[@]}"; do
+            for opt_level in $(config_opt_levels "${compiler}"); do
+                jobs+=("${project_name}:${compiler}:${opt_level}")
+            done
+        done
+    done
+
+    echo "============================================"
+    echo "Building ${#jobs[@]} configurations (${PERFECTION_JOBS} parallel jobs)"
+    echo "Projects: $*"
+    echo "============================================"
+
+    local failed=0
+    local running=0
+    local index=0
+    for job in "${jobs[@]}"; do
+        IFS=: read -r project_name compiler opt_level <<< "${job}"
+
+        if [ ${index} -eq 0 ]; then
+            build_configuration "${script_dir}" "${project_name}" "${compiler}" "${opt_level}" || failed=$((failed + 1))
+        else
+            build_configuration "${script_dir}" "${project_name}" "${compiler}" "${opt_level}" &
+            running=$((running + 1))
+            if [ ${running} -ge ${PERFECTION_JOBS} ]; then
+                wait -n || failed=$((failed + 1))
+                running=$((running - 1))
+            fi
+        fi
+        index=$((index + 1))
+    done
+
+    while [ ${running} -gt 0 ]; do
+        wait -n || failed=$((failed + 1))
+        running=$((running - 1))
+    done
+
+    echo ""
+    if [ ${failed} -ne 0 ]; then
+        echo "Error: ${failed} of ${#jobs[@]} configurations failed to build"
+        return 1
+    fi
+}
+
+# Print the benchmark arguments that enable hardware counters (nothing when disabled)
+# Usage: benchmark_counter_args
+benchmark_counter_args() {
+    if [ "${PERFECTION_COUNTERS}" = "1" ]; then
+        echo "--benchmark_perf_counters=${PERFECTION_DEFAULT_COUNTERS}"
+    elif [ -n "${PERFECTION_COUNTERS}" ]; then
+        echo "--benchmark_perf_counters=${PERFECTION_COUNTERS}"
+    fi
+}
+
+# Print the --benchmark_context argument recording a run's configuration metadata
+# (compiler, version, opt level, flag profile, CPU, governor, commit); stored in the JSON results.
+# The governor is the one of the first core in <cpus>, the taskset list the run is pinned to.
+# Usage: benchmark_context_arg <script_dir> <build_dir> <compiler> <opt_level> <cpus>
+benchmark_context_arg() {
+    local script_dir="$1"
+    local build_dir="$2"
+    local compiler="$3"
+    local opt_level="$4"
+    local cpus="$5"
+
+    local compiler_version
+    compiler_version=$(sed -n 's/^set(CMAKE_CXX_COMPILER_VERSION "\(.*\)")$/\1/p' \
+        "${build_dir}"/CMakeFiles/*/CMakeCXXCompiler.cmake 2>/dev/null | head -1)
+    local cpu
+    cpu=$(grep -m1 "^model name" /proc/cpuinfo 2>/dev/null | sed 's/^[^:]*: *//')
+    local governor
+    governor=$(cat "/sys/devices/system/cpu/cpu${cpus%%[,-]*}/cpufreq/scaling_governor" 2>/dev/null || true)
+    local commit
+    commit=$(git -C "${script_dir}" rev-parse --short HEAD 2>/dev/null || true)
+    if [ -n "${commit}" ] && [ -n "$(git -C "${script_dir}" status --porcelain --untracked-files=no 2>/dev/null)" ]; then
+        commit="${commit}-dirty"
+    fi
+
+    # Values must not contain commas (they separate key=value pairs)
+    local opt profile
+    read -r opt profile <<< "$(split_opt_level "${opt_level}")"
+    local context="config=${compiler}_${opt_level},compiler=${compiler},opt_level=${opt}"
+    context="${context},profile=${profile}"
+    context="${context},compiler_version=${compiler_version:-unknown}"
+    context="${context},cpu=${cpu//,/ }"
+    context="${context},governor=${governor:-unknown}"
+    context="${context},commit=${commit:-unknown}"
+    echo "--benchmark_context=${context}"
+}
+
+# Cores a project's benchmarks (or one of its binaries) are pinned to
+# Usage: project_bench_cpus <project_name> [binary_name]
+project_bench_cpus() {
+    local project_name="$1"
+    local binary_name="${2:-}"
+    local threaded
+    for threaded in "${THREADED_PROJECTS[@]}"; do
+        if [ "${project_name}" = "${threaded}" ] || [ "${project_name}/${binary_name}" = "${threaded}" ]; then
+            echo "${PERFECTION_THREADED_CPUS}"
+            return
+        fi
     done
+    echo "${PERFECTION_BENCH_CPU}"
+}
+
+# Run a command pinned to a taskset CPU list, e.g. from project_bench_cpus (falls back
+# to unpinned without taskset)
+# Usage: run_pinned <cpus> <command> [args...]
+run_pinned() {
+    local cpus="$1"
+    shift
+    if command -v taskset > /dev/null 2>&1; then
+        taskset -c "${cpus}" "$@"
+    else
+        "$@"
+    fi
+}
+
+# Run one benchmark binary of a configuration pinned to its cores (project_bench_cpus):
+# Google Benchmark JSON to .benchmarks/<project>/runs/<compiler>_<opt_level>/<binary>.json
+# (<binary>.rep<k>.json with PERFECTION_REPETITIONS > 1), filtered console output appended
+# to .benchmarks/<project>/benchmark.log
+# Usage: run_benchmark <script_dir> <project_name> <compiler> <opt_level> <binary> <repetition>
+run_benchmark() {
+    local script_dir="$1"
+    local project_name="$2"
+    local compiler="$3"
+    local opt_level="$4"
+    local binary="$5"
+    local rep="$6"
+
+    local benchmarks_dir="${script_dir}/.benchmarks/${project_name//\//_}"
+    local log_file="${benchmarks_dir}/benchmark.log"
+    local run_dir="${benchmarks_dir}/runs/${compiler}_${opt_level}"
+    local build_dir name cpus
+    build_dir=$(config_build_dir "${script_dir}" "${project_name}" "${compiler}" "${opt_level}")
+    name=$(basename "${binary}")
+    # Threaded binaries of otherwise single-core projects (THREADED_PROJECTS <project>/<binary>)
+    cpus=$(project_bench_cpus "${project_name}" "${name}")
+
+    local run_file="${run_dir}/${name}.json"
+    local rep_label=""
+    if [ "${PERFECTION_REPETITIONS}" -gt 1 ]; then
+        run_file="${run_dir}/${name}.rep${rep}.json"
+        rep_label=" (repetition ${rep}/${PERFECTION_REPETITIONS})"
+    fi
+    mkdir -p "${run_dir}"
+
+    echo "============================================"
+    echo "Running ${name} with ${compiler} -${opt_level}${rep_label}..."
+    echo "============================================"
+
+    echo "========== ${compiler} -${opt_level}${rep_label} ==========" >> "${log_file}"
+    echo "--- ${name} ---" >> "${log_file}"
+    run_pinned "${cpus}" "${binary}" $(benchmark_counter_args) \
+        "$(benchmark_context_arg "${script_dir}" "${build_dir}" "${compiler}" "${opt_level}" "${cpus}")" \
+        --benchmark_out="${run_file}" --benchmark_out_format=json 2>&1 | \
+        grep -E "^(Benchmark|BM_|[A-Z][A-Za-z]+/|---)" >> "${log_file}"
+    echo "" >> "${log_file}"
 }
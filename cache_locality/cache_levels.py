@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""
+Detect cache-level transitions from the cache_locality working-set sweep.
+
+Reads BM_pointer_chase/<bytes> (load latency) and BM_sequential/<bytes> (bandwidth) from
+.benchmarks/results.json and, per configuration, finds the working-set sizes where latency
+jumps. Each plateau between jumps is one level of the memory hierarchy:
+
+    | Level   | Working set          | Latency   | Sequential  |
+    |---------|----------------------|-----------|-------------|
+    | L1d     | 4 KB - 32 KB         |    1.9 ns |   11.5 GB/s |
+    | L2      | 64 KB - 1 MB         |    6.7 ns |   11.9 GB/s |
+    ...
+
+The host's cache sizes from sysfs are listed for comparison.
+Output: .benchmarks/cache_locality/cache_levels.md
+
+Usage:
+    python3 cache_locality/cache_levels.py [results.json]
+"""
+
+import sys
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+ROOT_DIR = Path(__file__).resolve().parent.parent
+sys.path.insert(0, str(ROOT_DIR))
+
+from generate_summary import order_config_names, project_report_main  # noqa: E402
+from perfection_results import median  # noqa: E402
+
+
+PROJECT = "cache_locality"
+
+# A latency step of at least this factor between neighbouring sizes starts a new level
+MIN_JUMP = 1.2
+
+
+def format_bytes(size: float) -> str:
+    """4096 -> '4 KB', 1048576 -> '1 MB'."""
+    for unit in ('B', 'KB', 'MB', 'GB'):
+        if size < 1024 or unit == 'GB':
+            return f"{size:.0f} {unit}"
+        size /= 1024
+    return f"{size:.0f} GB"
+
+
+def sweep(records: List[Dict], family: str, value) -> Dict[str, List[Tuple[int, float]]]:
+    """
+    Median of value(record) per config and working-set size for one benchmark family.
+    
+    Returns: {'gcc_O3': [(4096, 1.2), (8192, 1.2), ...]} sorted by size
+    """
+    samples = {}
+    for record in records:
+        family_name, _, size = record['benchmark'].rpartition('/')
+        if family_name != family or not size.isdigit():
+            continue
+        measured = value(record)
+        if measured is not None:
+            samples.setdefault(record['config'], {}).setdefault(int(size), []).append(measured)
+    return {config: sorted((size, median(values)) for size, values in sizes.items())
+            for config, sizes in samples.items()}
+
+
+def chase_latency_ns(record: Dict):
+    """Latency of one dependent load: inverse of the 'accesses' rate."""
+    accesses = record['counters'].get('accesses')
+    return 1e9 / accesses if accesses else None
+
+
+def sequential_gbps(record: Dict):
+    """Sequential read bandwidth in GB/s from SetBytesProcessed."""
+    bytes_per_second = record['counters'].get('bytes_per_second')
+    return bytes_per_second / 1e9 if bytes_per_second else None
+
+
+def find_transitions(latency: List[Tuple[int, float]]) -> List[int]:
+    """
+    Indices i where the level changes between latency[i] and latency[i + 1].
+    
+    A transition is a local maximum of the latency ratio between neighbouring sizes
+    that is at least MIN_JUMP; transitions spread over several sizes count once.
+    """
+    ratios = [latency[i + 1][1] / latency[i][1] for i in range(len(latency) - 1)]
+    transitions = []
+    for i, ratio in enumerate(ratios):
+        if ratio < MIN_JUMP:
+            continue
+        if i > 0 and ratios[i - 1] > ratio:
+            continue
+        if i + 1 < len(ratios) and ratios[i + 1] >= ratio:
+            continue
+        transitions.append(i)
+    return transitions
+
+
+def host_caches() -> List[Tuple[str, int]]:
+    """Data and unified caches of cpu0 from sysfs: [('L1d', 49152), ('L2', 2097152), ...]."""
+    units = {'K': 1024, 'M': 1024 ** 2, 'G': 1024 ** 3}
+    caches = []
+    for index in sorted(Path('/sys/devices/system/cpu/cpu0/cache').glob('index*')):
+        try:
+            cache_type = (index / 'type').read_text().strip()
+            level = (index / 'level').read_text().strip()
+            size = (index / 'size').read_text().strip()
+        except OSError:
+            continue
+        if cache_type == 'Instruction':
+            continue
+        suffix = 'd' if cache_type == 'Data' else ''
+        scale = units.get(size[-1], 1)
+        caches.append((f"L{level}{suffix}", int(size.rstrip('KMG')) * scale))
+    return caches
+
+
+def detect_levels(latency: List[Tuple[int, float]], bandwidth: Dict[int, float],
+                  caches: List[Tuple[str, int]]) -> List[Dict]:
+    """
+    Split the sweep into plateaus: [{'level', 'from', 'to', 'latency', 'bandwidth'}].
+    
+    A plateau is named after the host cache whose capacity lies between its largest size and
+    the first size of the next plateau. Unmatched steps (typically TLB reach with 4 KB pages)
+    are numbered; the plateau after the last step is main memory.
+    """
+    bounds = [-1] + find_transitions(latency) + [len(latency) - 1]
+    levels = []
+    for number, (start, end) in enumerate(zip(bounds, bounds[1:])):
+        points = latency[start + 1:end + 1]
+        sizes = [size for size, _ in points]
+        bandwidths = [bandwidth[size] for size in sizes if size in bandwidth]
+        
+        if end == len(latency) - 1 and number > 0:
+            name = "Memory"
+        else:
+            next_size = latency[end + 1][0] if end + 1 < len(latency) else sizes[-1]
+            matches = [cache for cache, capacity in caches if sizes[-1] <= capacity <= next_size]
+            name = matches[0] if matches else f"Level {number + 1}"
+        
+        levels.append({
+            'level': name,
+            'from': sizes[0],
+            'to': sizes[-1],
+            'latency': median([ns for _, ns in points]),
+            'bandwidth': median(bandwidths) if bandwidths else None,
+        })
+    return levels
+
+
+def generate_report(records: List[Dict]) -> str:
+    """Markdown report: host caches, then one level table per configuration."""
+    latency = sweep(records, 'BM_pointer_chase', chase_latency_ns)
+    bandwidth = sweep(records, 'BM_sequential', sequential_gbps)
+    
+    md = "# Cache Levels\n\n"
+    caches = host_caches()
+    if caches:
+        md += f"**Host caches (sysfs)**: {', '.join(f'{name} {format_bytes(size)}' for name, size in caches)}\n\n"
+        md += "Steps that match no cache capacity are numbered (usually TLB reach with 4 KB pages).\n\n"
+    if not latency:
+        return md + "No BM_pointer_chase results found (run: ./benchmarks.sh cache_locality).\n"
+    
+    for config in order_config_names(latency):
+        levels = detect_levels(latency[config], dict(bandwidth.get(config, [])), caches)
+        md += f"## {config}\n\n"
+        md += "| Level   | Working set          | Latency   | Sequential  |\n"
+        md += "|---------|----------------------|-----------|-------------|\n"
+        for level in levels:
+            span = f"{format_bytes(level['from'])} - {format_bytes(level['to'])}"
+            gbps = f"{level['bandwidth']:.1f} GB/s" if level['bandwidth'] is not None else "-"
+            md += f"| {level['level']:<7} | {span:<20} | {level['latency']:6.1f} ns | {gbps:>11} |\n"
+        md += "\n"
+    return md
+
+
+def main():
+    project_report_main(PROJECT, "cache_levels.md", generate_report)
+
+
+if __name__ == "__main__":
+    main()
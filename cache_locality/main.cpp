@@ -1,18 +1,28 @@
+#include <cstdint>
+#include <numeric>
 #include <random>
+#include <utility>
+#include <vector>
 #include <benchmark/benchmark.h>
 
-// 16MB array (4 million integers) - larger than typical L3 cache
-static constexpr size_t ARRAY_SIZE = 4 * 1024 * 1024;
-static int data[ARRAY_SIZE];
-
-void initialize_data() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1, 100);
-    
-    for (size_t i = 0; i < ARRAY_SIZE; ++i) {
-        data[i] = dis(gen);
+// Working-set sweep: 4KB (fits L1) to 1GB (DRAM), doubling each step.
+// Latency and bandwidth change at every cache capacity; cache_levels.py finds those transitions.
+static constexpr int64_t MIN_WORKING_SET = 4 * 1024;
+static constexpr int64_t MAX_WORKING_SET = 1024 * 1024 * 1024;
+
+// Strides of the strided kernel in bytes: one cache line, four cache lines, one page
+static constexpr int64_t STRIDES[] = {64, 256, 4096};
+
+// Loads per pointer-chasing iteration (keeps the time per iteration independent of the working set)
+static constexpr size_t CHASE_STEPS = 1024 * 1024;
+
+// Values do not matter for the sums, only the memory footprint does
+std::vector<int> make_data(size_t bytes) {
+    std::vector<int> data(bytes / sizeof(int));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<int>(i % 100) + 1;
     }
+    return data;
 }
 
 // Sequential access - good cache locality
@@ -20,53 +30,113 @@ void initialize_data() {
 // - Spatial locality (nearby elements in same cache line)
 // - Hardware prefetching (CPU can predict pattern)
 // - Full cache line utilization
-long long prfct_sum_sequential() {
+long long prfct_sum_sequential(const int* data, size_t size) {
     long long sum = 0;
-    for (size_t i = 0; i < ARRAY_SIZE; ++i) {
+    for (size_t i = 0; i < size; ++i) {
         sum += data[i];
     }
     return sum;
 }
 
 // Strided access - poor cache locality
-// Jumps across memory with large stride (1024 elements = 4KB)
+// Jumps across memory with a fixed stride (in elements)
 // This defeats:
 // - Hardware prefetching (unpredictable pattern)
 // - Cache efficiency (loads cache lines but uses small portion)
 // - Memory bandwidth (more main memory accesses)
-long long prfct_sum_strided() {
-    constexpr size_t STRIDE = 1024; // 4KB jumps (typical page size)
+long long prfct_sum_strided(const int* data, size_t size, size_t stride) {
     long long sum = 0;
-    
+
     // Process all elements by cycling through offsets
-    for (size_t offset = 0; offset < STRIDE; ++offset) {
-        for (size_t i = offset; i < ARRAY_SIZE; i += STRIDE) {
+    for (size_t offset = 0; offset < stride; ++offset) {
+        for (size_t i = offset; i < size; i += stride) {
             sum += data[i];
         }
     }
-    
+
     return sum;
 }
 
+// One node per cache line, so every step of the chase is a new line
+struct alignas(64) Node {
+    Node* next;
+};
+
+// Link the nodes into a single random cycle (Sattolo's algorithm):
+// the prefetcher cannot predict the next address, so each load pays the full latency
+// of the level the working set fits in
+void link_random_cycle(std::vector<Node>& nodes) {
+    std::vector<size_t> order(nodes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937_64 gen(42);
+    for (size_t i = order.size() - 1; i > 0; --i) {
+        std::uniform_int_distribution<size_t> dis(0, i - 1);
+        std::swap(order[i], order[dis(gen)]);
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+        nodes[order[i]].next = &nodes[order[(i + 1) % order.size()]];
+    }
+}
+
+// Pointer chasing - load-to-use latency
+// Every load depends on the previous one: no overlap, no prefetching
+const Node* prfct_chase_pointers(const Node* node, size_t steps) {
+    for (size_t i = 0; i < steps; ++i) {
+        node = node->next;
+    }
+    return node;
+}
+
+// Arguments: working set in bytes
 static void BM_sequential(benchmark::State& state) {
-    initialize_data();
-    
+    const size_t bytes = static_cast<size_t>(state.range(0));
+    std::vector<int> data = make_data(bytes);
+
     for (auto _ : state) {
-        long long result = prfct_sum_sequential();
+        long long result = prfct_sum_sequential(data.data(), data.size());
         benchmark::DoNotOptimize(result);
     }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes));
 }
 
+// Arguments: stride in bytes, working set in bytes
 static void BM_strided(benchmark::State& state) {
-    initialize_data();
-    
+    const size_t stride = static_cast<size_t>(state.range(0)) / sizeof(int);
+    const size_t bytes = static_cast<size_t>(state.range(1));
+    std::vector<int> data = make_data(bytes);
+
     for (auto _ : state) {
-        long long result = prfct_sum_strided();
+        long long result = prfct_sum_strided(data.data(), data.size(), stride);
         benchmark::DoNotOptimize(result);
     }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes));
+}
+
+// Arguments: working set in bytes
+// Reports 'accesses' (dependent loads per second); latency = 1 / accesses
+static void BM_pointer_chase(benchmark::State& state) {
+    std::vector<Node> nodes(static_cast<size_t>(state.range(0)) / sizeof(Node));
+    link_random_cycle(nodes);
+    const Node* node = nodes.data();
+
+    for (auto _ : state) {
+        node = prfct_chase_pointers(node, CHASE_STEPS);
+        benchmark::DoNotOptimize(node);
+    }
+    state.counters["accesses"] = benchmark::Counter(static_cast<double>(CHASE_STEPS),
+                                                    benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void strided_args(benchmark::internal::Benchmark* b) {
+    for (int64_t stride : STRIDES) {
+        for (int64_t bytes = MIN_WORKING_SET; bytes <= MAX_WORKING_SET; bytes *= 2) {
+            b->Args({stride, bytes});
+        }
+    }
 }
 
-BENCHMARK(BM_sequential);
-BENCHMARK(BM_strided);
+BENCHMARK(BM_sequential)->RangeMultiplier(2)->Range(MIN_WORKING_SET, MAX_WORKING_SET);
+BENCHMARK(BM_strided)->Apply(strided_args);
+BENCHMARK(BM_pointer_chase)->RangeMultiplier(2)->Range(MIN_WORKING_SET, MAX_WORKING_SET);
 
 BENCHMARK_MAIN();
@@ -18,39 +18,39 @@ else()
     message(FATAL_ERROR "Invalid compiler choice: ${COMPILER_CHOICE}. Use 'gcc' or 'clang'")
 endif()
 
-# Function to setup a benchmark project
-# Usage: perfection_setup_project(project_name)
-function(perfection_setup_project PROJECT_NAME)
-    # Set the C++ standard
-    set(CMAKE_CXX_STANDARD 17)
-    set(CMAKE_CXX_STANDARD_REQUIRED True)
+# Repository root and shared third-party directory (this file lives in <root>/cmake/)
+get_filename_component(PERFECTION_ROOT_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+set(THIRDPARTY_DIR "${PERFECTION_ROOT_DIR}/3rdparty")
+set(THIRDPARTY_SRC_DIR "${THIRDPARTY_DIR}/src")
+set(THIRDPARTY_BUILD_DIR "${THIRDPARTY_DIR}/.build")
 
-    # Option to set optimization level
-    set(OPTIMIZATION_LEVEL "O2" CACHE STRING "Optimization level: O0, O1, O2, O3, Os, Ofast")
-    set_property(CACHE OPTIMIZATION_LEVEL PROPERTY STRINGS O0 O1 O2 O3 Os Ofast)
-
-    # Apply optimization level
-    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -${OPTIMIZATION_LEVEL}" PARENT_SCOPE)
-    set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -${OPTIMIZATION_LEVEL}" PARENT_SCOPE)
-    message(STATUS "Using optimization level: -${OPTIMIZATION_LEVEL}")
+# Hardware performance counters (--benchmark_perf_counters) need Google Benchmark
+# built with libpfm; that build lives next to the plain one so both can coexist
+option(PERFECTION_ENABLE_LIBPFM "Build Google Benchmark with libpfm performance counters" OFF)
 
-    # Third-party dependencies setup
-    # Navigate up to project root (works for both single-level and nested projects)
-    get_filename_component(PROJECT_PARENT_DIR "${CMAKE_CURRENT_SOURCE_DIR}/.." ABSOLUTE)
-    if(EXISTS "${PROJECT_PARENT_DIR}/cmake/PerfectionCommon.cmake")
-        # Single-level project (e.g., inlining/)
-        set(THIRDPARTY_DIR "${PROJECT_PARENT_DIR}/3rdparty")
-    else()
-        # Nested project (e.g., containers/vector/)
-        get_filename_component(PROJECT_ROOT_DIR "${CMAKE_CURRENT_SOURCE_DIR}/../.." ABSOLUTE)
-        set(THIRDPARTY_DIR "${PROJECT_ROOT_DIR}/3rdparty")
+# Function to provide the shared third-party dependencies as one interface target
+# Usage: perfection_bench_target()
+#        target_link_libraries(my_binary PRIVATE perfection::bench)
+# perfection::bench carries Google Benchmark, Abseil (hash containers) and the header-only
+# Boost libraries. They are cloned and built once into 3rdparty/ and shared by every project
+# and configuration; later configures only find the prebuilt libraries.
+function(perfection_bench_target)
+    if(TARGET perfection::bench)
+        return()
     endif()
-    set(THIRDPARTY_SRC_DIR "${THIRDPARTY_DIR}/src")
-    set(THIRDPARTY_BUILD_DIR "${THIRDPARTY_DIR}/.build")
+
+    # Configurations are configured in parallel: one bootstraps, the others wait
+    file(MAKE_DIRECTORY "${THIRDPARTY_BUILD_DIR}")
+    file(LOCK "${THIRDPARTY_BUILD_DIR}/.bootstrap.lock" GUARD FUNCTION)
 
     # Google Benchmark setup
     set(BENCHMARK_SRC_DIR "${THIRDPARTY_SRC_DIR}/benchmark")
-    set(BENCHMARK_BUILD_DIR "${THIRDPARTY_BUILD_DIR}/benchmark")
+    if(PERFECTION_ENABLE_LIBPFM)
+        set(BENCHMARK_BUILD_DIR "${THIRDPARTY_BUILD_DIR}/benchmark_pfm")
+        message(STATUS "Using Google Benchmark with libpfm performance counters")
+    else()
+        set(BENCHMARK_BUILD_DIR "${THIRDPARTY_BUILD_DIR}/benchmark")
+    endif()
 
     # Check if Google Benchmark exists, if not clone and build it
     if(NOT EXISTS "${BENCHMARK_SRC_DIR}")
@@ -78,6 +78,7 @@ function(perfection_setup_project PROJECT_NAME)
             COMMAND ${CMAKE_COMMAND} -DCMAKE_BUILD_TYPE=Release 
                     -DBENCHMARK_DOWNLOAD_DEPENDENCIES=ON 
                     -DBENCHMARK_ENABLE_TESTING=OFF
+                    -DBENCHMARK_ENABLE_LIBPFM=${PERFECTION_ENABLE_LIBPFM}
                     "-DCMAKE_CXX_FLAGS_RELEASE=-O3 -DNDEBUG"
                     "${BENCHMARK_SRC_DIR}"
             WORKING_DIRECTORY "${BENCHMARK_BUILD_DIR}"
@@ -178,24 +179,10 @@ function(perfection_setup_project PROJECT_NAME)
         message(STATUS "Abseil already built at ${ABSEIL_BUILD_DIR}")
     endif()
 
-    # Add the executable
-    add_executable(${PROJECT_NAME} main.cpp)
-
-    # Add Google Benchmark include directories
-    target_include_directories(${PROJECT_NAME} PRIVATE 
+    add_library(perfection::bench INTERFACE IMPORTED)
+    set(BENCH_INCLUDES
         "${BENCHMARK_SRC_DIR}/include"
-    )
-    
-    # Link against pre-built Google Benchmark library
-    target_link_libraries(${PROJECT_NAME} PRIVATE 
-        "${BENCHMARK_BUILD_DIR}/src/libbenchmark.a"
-        pthread
-        rt
-    )
-
-    # Add Boost include directories (header-only)
-    # Boost libraries have their headers in libs/*/include
-    target_include_directories(${PROJECT_NAME} PRIVATE 
+        # Boost libraries have their headers in libs/*/include
         "${BOOST_SRC_DIR}/libs/container/include"
         "${BOOST_SRC_DIR}/libs/config/include"
         "${BOOST_SRC_DIR}/libs/assert/include"
@@ -204,14 +191,85 @@ function(perfection_setup_project PROJECT_NAME)
         "${BOOST_SRC_DIR}/libs/core/include"
         "${BOOST_SRC_DIR}/libs/move/include"
         "${BOOST_SRC_DIR}/libs/intrusive/include"
+        "${BOOST_SRC_DIR}/libs/pool/include"
+        "${BOOST_SRC_DIR}/libs/integer/include"
+        "${BOOST_SRC_DIR}/libs/throw_exception/include"
+        "${BOOST_SRC_DIR}/libs/unordered/include"
+        "${BOOST_SRC_DIR}/libs/container_hash/include"
+        "${BOOST_SRC_DIR}/libs/describe/include"
+        "${BOOST_SRC_DIR}/libs/mp11/include"
+        "${BOOST_SRC_DIR}/libs/predef/include"
+        "${BOOST_SRC_DIR}/libs/preprocessor/include"
+        "${BOOST_SRC_DIR}/libs/tuple/include"
+        "${ABSEIL_SRC_DIR}"
     )
-
-    # Add Abseil include directories
-    target_include_directories(${PROJECT_NAME} PRIVATE "${ABSEIL_SRC_DIR}")
-    
-    # Link Abseil libraries (needed for hash containers)
-    target_link_libraries(${PROJECT_NAME} PRIVATE 
-        "${ABSEIL_BUILD_DIR}/absl/container/libabsl_raw_hash_set.a"
-        "${ABSEIL_BUILD_DIR}/absl/container/libabsl_hashtablez_sampler.a"
+    # Abseil libraries needed for hash containers (raw_hash_set, hashtablez_sampler) and what
+    # they pull in (hash, synchronization, time, base, ...). Which library holds what changes
+    # between Abseil versions, so all of them are linked as one group; the linker only takes
+    # the objects that are referenced.
+    file(GLOB_RECURSE ABSEIL_LIBS "${ABSEIL_BUILD_DIR}/absl/*.a")
+    set(BENCH_LIBS
+        "${BENCHMARK_BUILD_DIR}/src/libbenchmark.a"
+        -Wl,--start-group ${ABSEIL_LIBS} -Wl,--end-group
+        pthread
+        rt
+    )
+    if(PERFECTION_ENABLE_LIBPFM)
+        list(APPEND BENCH_LIBS pfm)
+    endif()
+    set_target_properties(perfection::bench PROPERTIES
+        INTERFACE_INCLUDE_DIRECTORIES "${BENCH_INCLUDES}"
+        INTERFACE_LINK_LIBRARIES "${BENCH_LIBS}"
     )
 endfunction()
+
+# Function to add one benchmark binary to a project
+# Usage: perfection_add_benchmark(bench_insert bench_insert.cpp [more sources...])
+# The binary links perfection::bench and is listed in ${CMAKE_BINARY_DIR}/perfection_benchmarks.txt,
+# the manifest benchmarks.sh and disassembly.sh read to find every binary of a configuration.
+function(perfection_add_benchmark NAME)
+    perfection_bench_target()
+
+    add_executable(${NAME} ${ARGN})
+    target_link_libraries(${NAME} PRIVATE perfection::bench)
+
+    set_property(GLOBAL APPEND PROPERTY PERFECTION_BENCHMARKS ${NAME})
+    get_property(BENCHMARKS GLOBAL PROPERTY PERFECTION_BENCHMARKS)
+    string(REPLACE ";" "\n" MANIFEST "${BENCHMARKS}")
+    file(WRITE "${CMAKE_BINARY_DIR}/perfection_benchmarks.txt" "${MANIFEST}\n")
+endfunction()
+
+# Function to setup a benchmark project
+# Usage: perfection_setup_project(project_name)
+# A project with main.cpp gets one binary named after it; split suites add theirs
+# with perfection_add_benchmark() after this call.
+function(perfection_setup_project PROJECT_NAME)
+    # Set the C++ standard (also for binaries added by the caller)
+    set(CMAKE_CXX_STANDARD 17)
+    set(CMAKE_CXX_STANDARD_REQUIRED True)
+    set(CMAKE_CXX_STANDARD 17 PARENT_SCOPE)
+    set(CMAKE_CXX_STANDARD_REQUIRED True PARENT_SCOPE)
+
+    # Option to set optimization level
+    set(OPTIMIZATION_LEVEL "O2" CACHE STRING "Optimization level: O0, O1, O2, O3, Os, Ofast")
+    set_property(CACHE OPTIMIZATION_LEVEL PROPERTY STRINGS O0 O1 O2 O3 Os Ofast)
+
+    # Extra flags of the configuration's flag profile (flag_profiles.conf), e.g. -march=x86-64-v3 -flto=auto
+    set(PERFECTION_EXTRA_FLAGS "" CACHE STRING "Extra compile and link flags of the flag profile")
+
+    # Apply optimization level and extra flags (CMAKE_CXX_FLAGS also reach the link step, which LTO needs)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -${OPTIMIZATION_LEVEL} ${PERFECTION_EXTRA_FLAGS}" PARENT_SCOPE)
+    set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -${OPTIMIZATION_LEVEL} ${PERFECTION_EXTRA_FLAGS}" PARENT_SCOPE)
+    message(STATUS "Using optimization level: -${OPTIMIZATION_LEVEL}")
+    if(PERFECTION_EXTRA_FLAGS)
+        message(STATUS "Using extra flags: ${PERFECTION_EXTRA_FLAGS}")
+    endif()
+
+    # Shared third-party dependencies
+    perfection_bench_target()
+
+    # Single-binary project
+    if(EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/main.cpp")
+        perfection_add_benchmark(${PROJECT_NAME} main.cpp)
+    endif()
+endfunction()
@@ -0,0 +1,33 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PERFECTION_X86 1
+#include <immintrin.h>
+#endif
+
+// =============================================================================
+// Explicit SIMD Dispatch
+// =============================================================================
+// Hand-written vector kernels are compiled with __attribute__((target(...))) and only
+// run if the CPU supports the instruction set (CPUID), so a binary built with the
+// baseline flags still runs on any x86-64. Benchmarks of a missing instruction set
+// call state.SkipWithError().
+
+enum class Isa { SSE2, AVX2, AVX512, Native };
+
+// CPUID check (always true for Native: the baseline instruction set)
+inline bool cpu_supports(Isa isa) {
+#ifdef PERFECTION_X86
+    // Also called during static initialization (registration arguments)
+    __builtin_cpu_init();
+    switch (isa) {
+        case Isa::SSE2:   return __builtin_cpu_supports("sse2");
+        case Isa::AVX2:   return __builtin_cpu_supports("avx2");
+        case Isa::AVX512: return __builtin_cpu_supports("avx512f");
+        case Isa::Native: return true;
+    }
+    return false;
+#else
+    return isa == Isa::Native;
+#endif
+}
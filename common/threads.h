@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+// =============================================================================
+// Thread Sweeps for Multithreaded Benchmarks
+// =============================================================================
+// Shared by the binaries listed in THREADED_PROJECTS (build_common.sh). They register
+// ->ThreadRange(1, max_threads())->UseRealTime(): with real time the reported rates are
+// aggregate throughput (total work / wall time) instead of per-thread CPU time, which
+// Google Benchmark sums over the threads.
+
+// Upper bound of the thread sweep
+static constexpr int MAX_THREADS = 256;
+
+// Thread counts: 1, 2, 4, ... up to the cores the process may run on
+// (benchmarks.sh restricts them to PERFECTION_THREADED_CPUS)
+static int max_threads() {
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        cores = CPU_COUNT(&allowed);
+    }
+#endif
+    return std::clamp(cores, 1, MAX_THREADS);
+}
@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+"""
+Compare a results store against a saved baseline and gate on regressions.
+
+Every (project, config, benchmark) present in both stores is compared on CPU time
+(wall time for UseRealTime() and multithreaded benchmarks, see measured_time_ns()):
+median change and Mann-Whitney U p-value over the repetitions (PERFECTION_REPETITIONS).
+Below MIN_SAMPLES per side the test cannot reach p < 0.05 (3 vs 3: p >= 0.081), so such
+comparisons are reported as untestable.
+
+A regression fails the gate when it is slower by more than --threshold percent and
+statistically significant (p < --alpha). Exit codes:
+    0  every benchmark compared, no regression
+    1  at least one regression
+    2  no regression found, but the gate is incomplete: untestable comparisons (too few
+       repetitions, e.g. the default PERFECTION_REPETITIONS=1), benchmarks present in
+       only one of the stores, or nothing to compare
+
+Usage:
+    python3 compare_results.py save <name> [store]
+    python3 compare_results.py <baseline> [current] [--threshold PCT] [--alpha P] [--project NAME]
+
+<baseline> is a store path or the name of a saved baseline (.benchmarks/baselines/<name>.json);
+[current] defaults to .benchmarks/results.json.
+
+Example:
+    python3 compare_results.py save gcc-12
+    # ... upgrade the compiler, rerun ./run_all.sh ...
+    python3 compare_results.py gcc-12 --threshold 5
+"""
+
+import argparse
+import shutil
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+from generate_summary import format_time
+from perfection_results import STORE_NAME, group_samples, load_store, mann_whitney_u, summarize
+
+
+BENCHMARKS_DIR = Path(__file__).parent / '.benchmarks'
+BASELINES_DIR = BENCHMARKS_DIR / 'baselines'
+
+# Samples needed on each side for a test (4 vs 4: smallest p = 0.030)
+MIN_SAMPLES = 4
+
+
+def resolve_store(name_or_path: str) -> Path:
+    """A store path as given, or the saved baseline of that name."""
+    path = Path(name_or_path)
+    if path.exists():
+        return path
+    return BASELINES_DIR / f"{name_or_path}.json"
+
+
+def save_baseline(name: str, store_path: Path) -> Path:
+    """Snapshot a store as .benchmarks/baselines/<name>.json."""
+    BASELINES_DIR.mkdir(parents=True, exist_ok=True)
+    baseline_path = BASELINES_DIR / f"{name}.json"
+    shutil.copyfile(store_path, baseline_path)
+    return baseline_path
+
+
+def compare(baseline: List[Dict], current: List[Dict], threshold: float, alpha: float) -> List[Dict]:
+    """
+    Compare every benchmark present in both record sets.
+    
+    Returns one entry per (project, config, benchmark):
+        {'key': (...), 'baseline': ns, 'current': ns, 'change': %, 'p': p-value, 'verdict': ...}
+    verdict: 'regression' / 'improvement' (significant and beyond threshold),
+             'slower' / 'faster' (significant, within threshold), 'unchanged',
+             'untestable' (fewer than MIN_SAMPLES on either side)
+    """
+    baseline_samples = group_samples(baseline)
+    current_samples = group_samples(current)
+    
+    comparisons = []
+    for key in sorted(baseline_samples.keys() & current_samples.keys()):
+        before = baseline_samples[key]
+        after = current_samples[key]
+        before_median = summarize(before)['median']
+        after_median = summarize(after)['median']
+        change = 100 * (after_median - before_median) / before_median if before_median else 0.0
+        
+        testable = len(before) >= MIN_SAMPLES and len(after) >= MIN_SAMPLES
+        p = mann_whitney_u(after, before) if testable else None
+        
+        if not testable:
+            verdict = 'untestable'
+        elif p >= alpha or change == 0:
+            verdict = 'unchanged'
+        elif change > 0:
+            verdict = 'regression' if change > threshold else 'slower'
+        else:
+            verdict = 'improvement' if -change > threshold else 'faster'
+        
+        comparisons.append({
+            'key': key,
+            'baseline': before_median,
+            'current': after_median,
+            'change': change,
+            'p': p,
+            'verdict': verdict,
+        })
+    return comparisons
+
+
+def format_table(comparisons: List[Dict]) -> str:
+    """Markdown table of comparisons, in the given order."""
+    header = ['Project', 'Config', 'Benchmark', 'Baseline', 'Current', 'Change', 'p', 'Verdict']
+    rows = []
+    for c in comparisons:
+        project, config, benchmark = c['key']
+        rows.append([
+            project, config, benchmark,
+            format_time(c['baseline']), format_time(c['current']),
+            f"{c['change']:+.1f}%",
+            f"{c['p']:.3f}" if c['p'] is not None else "n/a",
+            c['verdict'],
+        ])
+    
+    widths = [max(len(header[i]), *(len(row[i]) for row in rows)) for i in range(len(header))]
+    lines = ["| " + " | ".join(h.ljust(w) for h, w in zip(header, widths)) + " |"]
+    lines.append("|" + "|".join("-" * (w + 2) for w in widths) + "|")
+    for row in rows:
+        # Left-align names, right-align numbers
+        cells = [cell.ljust(w) if i < 3 or i == 7 else cell.rjust(w) for i, (cell, w) in enumerate(zip(row, widths))]
+        lines.append("| " + " | ".join(cells) + " |")
+    return "\n".join(lines) + "\n"
+
+
+def report(comparisons: List[Dict], threshold: float, missing: List[Tuple[Tuple[str, str, str], str]]) -> str:
+    """
+    Ranked report: regressions (worst first), then improvements (best first), then untestable
+    comparisons whose medians moved beyond the threshold and benchmarks missing from one store.
+    """
+    slower = sorted((c for c in comparisons if c['verdict'] in ('regression', 'slower')),
+                    key=lambda c: -c['change'])
+    faster = sorted((c for c in comparisons if c['verdict'] in ('improvement', 'faster')),
+                    key=lambda c: c['change'])
+    untestable = sum(c['verdict'] == 'untestable' for c in comparisons)
+    unchanged = len(comparisons) - len(slower) - len(faster) - untestable
+    # Medians only: a hint where to rerun with more repetitions, not a verdict
+    suspect = sorted((c for c in comparisons if c['verdict'] == 'untestable' and abs(c['change']) > threshold),
+                     key=lambda c: -c['change'])
+    
+    md = f"# Comparison against baseline (threshold {threshold:g}%)\n\n"
+    md += f"- Compared: {len(comparisons)}\n"
+    md += f"- Regressions beyond threshold: {sum(c['verdict'] == 'regression' for c in comparisons)}\n"
+    md += f"- Improvements beyond threshold: {sum(c['verdict'] == 'improvement' for c in comparisons)}\n"
+    md += f"- Unchanged (not significant): {unchanged}\n"
+    if untestable:
+        md += f"- Untestable (fewer than {MIN_SAMPLES} samples per side): {untestable}\n"
+    if missing:
+        md += f"- Present in only one of the stores: {len(missing)}\n"
+    md += "\n"
+    
+    if slower:
+        md += "## Slower\n\n" + format_table(slower) + "\n"
+    if faster:
+        md += "## Faster\n\n" + format_table(faster) + "\n"
+    if suspect:
+        md += f"## Untestable, median beyond {threshold:g}%\n\n" + format_table(suspect) + "\n"
+    if missing:
+        md += "## Missing\n\n"
+        for (project, config, benchmark), side in missing:
+            md += f"- {project} {config} {benchmark}: only in the {side} store\n"
+        md += "\n"
+    return md
+
+
+def main():
+    if len(sys.argv) > 1 and sys.argv[1] == 'save':
+        if len(sys.argv) not in (3, 4):
+            print(f"Usage: {sys.argv[0]} save <name> [store]")
+            sys.exit(1)
+        store_path = Path(sys.argv[3]) if len(sys.argv) == 4 else BENCHMARKS_DIR / STORE_NAME
+        if not store_path.exists():
+            print(f"Error: File not found: {store_path}")
+            sys.exit(1)
+        print(f"✓ Saved baseline: {save_baseline(sys.argv[2], store_path)}")
+        return
+    
+    parser = argparse.ArgumentParser(description="Compare a results store against a baseline.")
+    parser.add_argument('baseline', help="baseline store path or saved baseline name")
+    parser.add_argument('current', nargs='?', default=str(BENCHMARKS_DIR / STORE_NAME),
+                        help="current store (default: .benchmarks/results.json)")
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help="regression threshold in percent (default: 5)")
+    parser.add_argument('--alpha', type=float, default=0.05,
+                        help="significance level of the Mann-Whitney U test (default: 0.05)")
+    parser.add_argument('--project', help="compare one project only")
+    args = parser.parse_args()
+    
+    baseline_path = resolve_store(args.baseline)
+    current_path = Path(args.current)
+    for path in (baseline_path, current_path):
+        if not path.exists():
+            print(f"Error: File not found: {path}")
+            sys.exit(1)
+    
+    project: Optional[str] = args.project
+    baseline = load_store(baseline_path, project)
+    current = load_store(current_path, project)
+    
+    comparisons = compare(baseline, current, args.threshold, args.alpha)
+    keys_before = group_samples(baseline).keys()
+    keys_after = group_samples(current).keys()
+    missing = sorted([(key, 'baseline') for key in keys_before - keys_after] +
+                     [(key, 'current') for key in keys_after - keys_before])
+    
+    print(report(comparisons, args.threshold, missing))
+    
+    regressions = [c for c in comparisons if c['verdict'] == 'regression']
+    if regressions:
+        print(f"✗ {len(regressions)} regression(s) beyond {args.threshold:g}%")
+        sys.exit(1)
+    
+    untestable = sum(c['verdict'] == 'untestable' for c in comparisons)
+    if not comparisons:
+        print("✗ No benchmark present in both stores")
+        sys.exit(2)
+    if untestable or missing:
+        if untestable:
+            print(f"✗ {untestable} comparison(s) untestable: rerun with PERFECTION_REPETITIONS >= {MIN_SAMPLES}")
+        if missing:
+            print(f"✗ {len(missing)} benchmark(s) present in only one of the stores")
+        sys.exit(2)
+    print("✓ No regressions beyond threshold")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// =============================================================================
+// Common Definitions for the Container Suites
+// =============================================================================
+// Type lists, the keys of the associative suites (containers/hashmap, containers/ordered)
+// and their benchmark registration.
+
+template<typename... Ts>
+struct TypeList {};
+
+// Container sizes (elements): L1-resident (int keys), L2/L3-resident, DRAM-resident
+static constexpr size_t SIZES[] = {1024, 32 * 1024, 1024 * 1024};
+
+// =============================================================================
+// Keys
+// =============================================================================
+
+// String key of Length characters (std::string)
+template<size_t Length>
+struct StringKey {};
+
+// Key number id -> key. Even ids are inserted (present), odd ids never are (absent:
+// hash lookups miss, ordered lookups fall between present keys). Ids are scrambled by an
+// odd multiplier (a bijection that keeps the parity) so consecutive ids do not give
+// consecutive keys and the insertion order is not the key order.
+inline uint32_t scramble(uint32_t id) { return id * 0x9E3779B1u; }
+
+template<typename Key>
+struct KeyTraits;
+
+template<>
+struct KeyTraits<int> {
+    using Type = int;
+    static std::string name() { return "int"; }
+    static int make(uint32_t id) { return static_cast<int>(scramble(id)); }
+};
+
+template<size_t Length>
+struct KeyTraits<StringKey<Length>> {
+    using Type = std::string;
+    static std::string name() { return "Str" + std::to_string(Length); }
+
+    // 8 hex digits of the scrambled id, most significant first (string order follows
+    // the scrambled value), padded with letters derived from it
+    static std::string make(uint32_t id) {
+        static constexpr char HEX[] = "0123456789abcdef";
+        uint32_t bits = scramble(id);
+        std::string key(Length, 'a');
+        for (size_t i = 0; i < 8; ++i) {
+            key[i] = HEX[(bits >> (28 - i * 4)) & 0xF];
+        }
+        for (size_t i = 8; i < Length; ++i) {
+            key[i] = static_cast<char>('a' + (bits + i * 7) % 26);
+        }
+        return key;
+    }
+};
+
+// Keys of the container (present) or keys that are never inserted (absent), shuffled
+template<typename Key>
+std::vector<typename KeyTraits<Key>::Type> make_keys(size_t count, bool present, unsigned seed = 42) {
+    std::vector<typename KeyTraits<Key>::Type> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        keys.push_back(KeyTraits<Key>::make(static_cast<uint32_t>(2 * i + (present ? 0 : 1))));
+    }
+    std::mt19937 gen(seed);
+    std::shuffle(keys.begin(), keys.end(), gen);
+    return keys;
+}
+
+// =============================================================================
+// Registration
+// =============================================================================
+// A benchmark is a class template Bench<Map, Key> with a static run(State&, size_t size);
+// a container kind has a name and a template<typename Key> using type = ....
+// Names follow containers/vector: <Operation>/<Key>/<Container>/<Size>, e.g.
+// Lookup_Hit/Str64/AbslFlat/1048576; generate_summary.py groups them per operation,
+// key and size.
+
+template<template<template<typename> class, typename> class Bench, typename Kind, typename Key>
+void register_benchmark(const std::string& operation) {
+    std::string name = operation + "/" + KeyTraits<Key>::name() + "/" + Kind::name;
+    auto* bench = benchmark::RegisterBenchmark(name.c_str(), [](benchmark::State& state) {
+        Bench<Kind::template type, Key>::run(state, static_cast<size_t>(state.range(0)));
+    });
+    for (size_t size : SIZES) {
+        bench->Arg(static_cast<int64_t>(size));
+    }
+}
+
+template<template<template<typename> class, typename> class Bench, typename Key, typename... Kinds>
+void register_key(const std::string& operation, TypeList<Kinds...>) {
+    (register_benchmark<Bench, Kinds, Key>(operation), ...);
+}
+
+// Register Bench for every container kind of Containers and every key of Keys
+template<template<template<typename> class, typename> class Bench, typename Containers, typename... Keys>
+bool register_suite(const std::string& operation, TypeList<Keys...>) {
+    (register_key<Bench, Keys>(operation, Containers{}), ...);
+    return true;
+}
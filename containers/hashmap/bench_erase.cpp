@@ -0,0 +1,39 @@
+#include "common.h"
+
+// =============================================================================
+// ERASE Benchmarks
+// =============================================================================
+// Steady state of a cache: each iteration erases BATCH keys and inserts them again,
+// so the table keeps `size` elements (and open-addressing tables accumulate and
+// reuse tombstones). Time covers both; items are the erased keys.
+
+template<template<typename> class Map, typename Key>
+struct Erase {
+    using Table = Map<typename KeyTraits<Key>::Type>;
+
+    static void run(benchmark::State& state, size_t size) {
+        Table table = make_table<Table>(make_keys<Key>(size, true));
+        const auto victims = make_keys<Key>(size, true, 7);
+        size_t cursor = 0;
+
+        for (auto _ : state) {
+            const size_t begin = cursor;
+            for (size_t i = 0; i < BATCH; ++i) {
+                table.erase(victims[cursor]);
+                cursor = cursor + 1 == size ? 0 : cursor + 1;
+            }
+            cursor = begin;
+            for (size_t i = 0; i < BATCH; ++i) {
+                table.emplace(victims[cursor], static_cast<Value>(i));
+                cursor = cursor + 1 == size ? 0 : cursor + 1;
+            }
+            benchmark::DoNotOptimize(table);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+    }
+};
+
+static const bool registered = register_all<Erase>("Erase");
+
+BENCHMARK_MAIN();
@@ -0,0 +1,36 @@
+#include "common.h"
+
+// =============================================================================
+// INSERT Benchmarks
+// =============================================================================
+// Build a table of `size` distinct keys from empty, including rehashes (Insert)
+// or with the buckets reserved up front (Insert_Reserved), and destroy it.
+
+template<bool Reserve>
+struct Insert {
+    template<template<typename> class Map, typename Key>
+    struct Bench {
+        using Table = Map<typename KeyTraits<Key>::Type>;
+
+        static void run(benchmark::State& state, size_t size) {
+            const auto keys = make_keys<Key>(size, true);
+            for (auto _ : state) {
+                Table table;
+                if (Reserve) {
+                    table.reserve(size);
+                }
+                for (size_t i = 0; i < size; ++i) {
+                    table.emplace(keys[i], static_cast<Value>(i));
+                }
+                benchmark::DoNotOptimize(table);
+                benchmark::ClobberMemory();
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+        }
+    };
+};
+
+static const bool registered = register_all<Insert<false>::Bench>("Insert") &&
+                               register_all<Insert<true>::Bench>("Insert_Reserved");
+
+BENCHMARK_MAIN();
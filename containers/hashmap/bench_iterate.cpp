@@ -0,0 +1,29 @@
+#include "common.h"
+
+// =============================================================================
+// ITERATE Benchmarks
+// =============================================================================
+// Sum the mapped values of the whole table: node-based tables chase one pointer
+// per element, flat tables scan their slot arrays (including empty slots).
+
+template<template<typename> class Map, typename Key>
+struct Iterate {
+    using Table = Map<typename KeyTraits<Key>::Type>;
+
+    static void run(benchmark::State& state, size_t size) {
+        const Table table = make_table<Table>(make_keys<Key>(size, true));
+
+        for (auto _ : state) {
+            Value sum = 0;
+            for (const auto& entry : table) {
+                sum += entry.second;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+    }
+};
+
+static const bool registered = register_all<Iterate>("Iterate");
+
+BENCHMARK_MAIN();
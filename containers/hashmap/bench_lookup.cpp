@@ -0,0 +1,40 @@
+#include "common.h"
+
+// =============================================================================
+// LOOKUP Benchmarks
+// =============================================================================
+// BATCH find() calls per iteration on a table of `size` keys, walking through all
+// keys in a different shuffled order than they were inserted. Lookup_Hit finds
+// every key, Lookup_Miss none (same key distribution, never inserted).
+
+template<bool Hits>
+struct Lookup {
+    template<template<typename> class Map, typename Key>
+    struct Bench {
+        using Table = Map<typename KeyTraits<Key>::Type>;
+
+        static void run(benchmark::State& state, size_t size) {
+            const Table table = make_table<Table>(make_keys<Key>(size, true));
+            const auto probes = make_keys<Key>(size, Hits, 7);
+            size_t cursor = 0;
+
+            for (auto _ : state) {
+                Value sum = 0;
+                for (size_t i = 0; i < BATCH; ++i) {
+                    auto it = table.find(probes[cursor]);
+                    if (it != table.end()) {
+                        sum += it->second;
+                    }
+                    cursor = cursor + 1 == size ? 0 : cursor + 1;
+                }
+                benchmark::DoNotOptimize(sum);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+        }
+    };
+};
+
+static const bool registered = register_all<Lookup<true>::Bench>("Lookup_Hit") &&
+                               register_all<Lookup<false>::Bench>("Lookup_Miss");
+
+BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+#include "common.h"
+
+// =============================================================================
+// MIXED Benchmarks
+// =============================================================================
+// A lookup-heavy request mix on random keys: 80% hits, 10% misses, 10% updates
+// (erase a key and insert it again). BATCH operations per iteration from a
+// precomputed stream of `size` operations.
+
+enum class Op : uint8_t { Hit, Miss, Update };
+
+struct Step {
+    Op op;
+    uint32_t index;
+};
+
+static std::vector<Step> make_steps(size_t size) {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<uint32_t> index(0, static_cast<uint32_t>(size - 1));
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::vector<Step> steps(size);
+    for (Step& step : steps) {
+        int p = percent(gen);
+        step.op = p < 80 ? Op::Hit : p < 90 ? Op::Miss : Op::Update;
+        step.index = index(gen);
+    }
+    return steps;
+}
+
+template<template<typename> class Map, typename Key>
+struct Mixed {
+    using Table = Map<typename KeyTraits<Key>::Type>;
+
+    static void run(benchmark::State& state, size_t size) {
+        const auto keys = make_keys<Key>(size, true);
+        const auto misses = make_keys<Key>(size, false);
+        Table table = make_table<Table>(keys);
+        const std::vector<Step> steps = make_steps(size);
+        size_t cursor = 0;
+
+        for (auto _ : state) {
+            Value sum = 0;
+            for (size_t i = 0; i < BATCH; ++i) {
+                const Step& step = steps[cursor];
+                switch (step.op) {
+                    case Op::Hit: {
+                        auto it = table.find(keys[step.index]);
+                        if (it != table.end()) {
+                            sum += it->second;
+                        }
+                        break;
+                    }
+                    case Op::Miss:
+                        sum += table.count(misses[step.index]);
+                        break;
+                    case Op::Update:
+                        table.erase(keys[step.index]);
+                        table.emplace(keys[step.index], static_cast<Value>(i));
+                        break;
+                }
+                cursor = cursor + 1 == size ? 0 : cursor + 1;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+    }
+};
+
+static const bool registered = register_all<Mixed>("Mixed");
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <unordered_map>
+
+// Keys, sizes and registration shared with containers/ordered
+#include "../common.h"
+
+// Abseil hash containers
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/node_hash_map.h>
+
+// Boost hash containers (open addressing since Boost 1.81)
+#include <boost/unordered_map.hpp>
+#if __has_include(<boost/unordered/unordered_flat_map.hpp>)
+#include <boost/unordered/unordered_flat_map.hpp>
+#define PERFECTION_HAS_BOOST_FLAT_MAP 1
+#endif
+
+// =============================================================================
+// Common Definitions for Hash Map Benchmarks
+// =============================================================================
+
+// Mapped value of every table
+using Value = uint64_t;
+
+// Containers under test, each with its default hash
+struct StdUnorderedKind {
+    static constexpr const char* name = "StdUnordered";
+    template<typename Key> using type = std::unordered_map<Key, Value>;
+};
+
+struct AbslFlatKind {
+    static constexpr const char* name = "AbslFlat";
+    template<typename Key> using type = absl::flat_hash_map<Key, Value>;
+};
+
+struct AbslNodeKind {
+    static constexpr const char* name = "AbslNode";
+    template<typename Key> using type = absl::node_hash_map<Key, Value>;
+};
+
+struct BoostUnorderedKind {
+    static constexpr const char* name = "BoostUnordered";
+    template<typename Key> using type = boost::unordered_map<Key, Value>;
+};
+
+#ifdef PERFECTION_HAS_BOOST_FLAT_MAP
+struct BoostFlatKind {
+    static constexpr const char* name = "BoostFlat";
+    template<typename Key> using type = boost::unordered_flat_map<Key, Value>;
+};
+#endif
+
+using Containers = TypeList<StdUnorderedKind, AbslFlatKind, AbslNodeKind, BoostUnorderedKind
+#ifdef PERFECTION_HAS_BOOST_FLAT_MAP
+                            , BoostFlatKind
+#endif
+                            >;
+
+// Keys: int, 8-character string (fits the small-string buffer), 64-character string (heap)
+using Keys = TypeList<int, StringKey<8>, StringKey<64>>;
+
+// Operations per iteration of the lookup, erase and mixed benchmarks. Successive
+// iterations continue through the (shuffled) keys, so large tables are not cached.
+static constexpr size_t BATCH = 1024;
+
+template<typename Map, typename KeyVector>
+Map make_table(const KeyVector& keys) {
+    Map table;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        table.emplace(keys[i], static_cast<Value>(i));
+    }
+    return table;
+}
+
+// Register Bench for every container and key type (see containers/common.h)
+template<template<template<typename> class, typename> class Bench>
+bool register_all(const std::string& operation) {
+    return register_suite<Bench, Containers>(operation, Keys{});
+}
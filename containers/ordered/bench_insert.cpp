@@ -0,0 +1,30 @@
+#include "common.h"
+
+// =============================================================================
+// BULK INSERT Benchmarks
+// =============================================================================
+// Build a container from `size` entries in random key order with one range insert
+// (insert(first, last)) and destroy it. Trees insert entry by entry; flat_map and
+// the sorted vector append, sort and deduplicate (inserting one at a time into a
+// flat layout is quadratic).
+
+template<template<typename> class Map, typename Key>
+struct BulkInsert {
+    using Container = Map<typename KeyTraits<Key>::Type>;
+
+    static void run(benchmark::State& state, size_t size) {
+        const auto entries = make_entries<Key>(size);
+
+        for (auto _ : state) {
+            Container container;
+            container.insert(entries.begin(), entries.end());
+            benchmark::DoNotOptimize(container);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+    }
+};
+
+static const bool registered = register_all<BulkInsert>("BulkInsert");
+
+BENCHMARK_MAIN();
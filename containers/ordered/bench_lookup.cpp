@@ -0,0 +1,40 @@
+#include "common.h"
+
+// =============================================================================
+// LOOKUP Benchmarks
+// =============================================================================
+// BATCH searches per iteration in a container of `size` keys, walking through the
+// probes in shuffled order. Lookup: find() of present keys. LowerBound: lower_bound()
+// of absent keys (between two present ones), the first step of every range query.
+
+template<bool Present>
+struct Search {
+    template<template<typename> class Map, typename Key>
+    struct Bench {
+        using Container = Map<typename KeyTraits<Key>::Type>;
+
+        static void run(benchmark::State& state, size_t size) {
+            const Container container = make_container<Container>(make_entries<Key>(size));
+            const auto probes = make_keys<Key>(size, Present, 7);
+            size_t cursor = 0;
+
+            for (auto _ : state) {
+                Value sum = 0;
+                for (size_t i = 0; i < BATCH; ++i) {
+                    auto it = Present ? container.find(probes[cursor]) : container.lower_bound(probes[cursor]);
+                    if (it != container.end()) {
+                        sum += it->second;
+                    }
+                    cursor = cursor + 1 == size ? 0 : cursor + 1;
+                }
+                benchmark::DoNotOptimize(sum);
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+        }
+    };
+};
+
+static const bool registered = register_all<Search<true>::Bench>("Lookup") &&
+                               register_all<Search<false>::Bench>("LowerBound");
+
+BENCHMARK_MAIN();
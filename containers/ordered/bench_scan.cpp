@@ -0,0 +1,43 @@
+#include "common.h"
+
+// =============================================================================
+// RANGE SCAN Benchmarks
+// =============================================================================
+// Range queries: lower_bound() of a random key, then sum the next SCAN_LENGTH
+// entries in key order. Node-based trees follow one pointer per entry, B-trees
+// scan nodes of several entries, flat layouts read contiguous memory.
+
+static constexpr size_t SCANS = 64;
+static constexpr size_t SCAN_LENGTH = 128;
+
+template<template<typename> class Map, typename Key>
+struct RangeScan {
+    using Container = Map<typename KeyTraits<Key>::Type>;
+
+    static void run(benchmark::State& state, size_t size) {
+        const Container container = make_container<Container>(make_entries<Key>(size));
+        const auto probes = make_keys<Key>(size, false, 7);
+        size_t cursor = 0;
+        // Scans starting near the largest key stop early at end(), so entries are counted
+        int64_t visited = 0;
+
+        for (auto _ : state) {
+            Value sum = 0;
+            for (size_t i = 0; i < SCANS; ++i) {
+                auto it = container.lower_bound(probes[cursor]);
+                size_t n = 0;
+                for (; n < SCAN_LENGTH && it != container.end(); ++n, ++it) {
+                    sum += it->second;
+                }
+                visited += static_cast<int64_t>(n);
+                cursor = cursor + 1 == size ? 0 : cursor + 1;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(visited);
+    }
+};
+
+static const bool registered = register_all<RangeScan>("RangeScan");
+
+BENCHMARK_MAIN();
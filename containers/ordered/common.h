@@ -0,0 +1,111 @@
+#pragma once
+
+#include <map>
+#include <utility>
+
+// Keys, sizes and registration shared with containers/hashmap
+#include "../common.h"
+
+// Abseil B-tree
+#include <absl/container/btree_map.h>
+
+// Boost flat (sorted vector) map
+#include <boost/container/flat_map.hpp>
+
+// =============================================================================
+// Common Definitions for Ordered Container Benchmarks
+// =============================================================================
+
+// Mapped value of every container
+using Value = uint64_t;
+
+// Sorted std::vector of pairs searched with std::lower_bound: the baseline flat layout
+template<typename Key, typename Mapped>
+class SortedVector {
+public:
+    using value_type = std::pair<Key, Mapped>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    const_iterator begin() const { return data_.begin(); }
+    const_iterator end() const { return data_.end(); }
+    size_t size() const { return data_.size(); }
+
+    const_iterator lower_bound(const Key& key) const {
+        return std::lower_bound(data_.begin(), data_.end(), key,
+                                [](const value_type& entry, const Key& k) { return entry.first < k; });
+    }
+
+    const_iterator find(const Key& key) const {
+        const_iterator it = lower_bound(key);
+        return it != data_.end() && it->first == key ? it : data_.end();
+    }
+
+    // Bulk insert: append, sort, keep the first of equal keys (like map::insert)
+    template<typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        data_.insert(data_.end(), first, last);
+        std::stable_sort(data_.begin(), data_.end(),
+                         [](const value_type& a, const value_type& b) { return a.first < b.first; });
+        data_.erase(std::unique(data_.begin(), data_.end(),
+                                [](const value_type& a, const value_type& b) { return a.first == b.first; }),
+                    data_.end());
+    }
+
+private:
+    std::vector<value_type> data_;
+};
+
+// Containers under test
+struct StdMapKind {
+    static constexpr const char* name = "StdMap";
+    template<typename Key> using type = std::map<Key, Value>;
+};
+
+struct AbslBtreeKind {
+    static constexpr const char* name = "AbslBtree";
+    template<typename Key> using type = absl::btree_map<Key, Value>;
+};
+
+struct BoostFlatKind {
+    static constexpr const char* name = "BoostFlat";
+    template<typename Key> using type = boost::container::flat_map<Key, Value>;
+};
+
+struct SortedVectorKind {
+    static constexpr const char* name = "SortedVector";
+    template<typename Key> using type = SortedVector<Key, Value>;
+};
+
+using Containers = TypeList<StdMapKind, AbslBtreeKind, BoostFlatKind, SortedVectorKind>;
+
+// Keys: int, 16-character string (just past the small-string buffer: one heap block per key)
+using Keys = TypeList<int, StringKey<16>>;
+
+// Searches per iteration of the lookup benchmarks. Successive iterations continue
+// through the (shuffled) probe keys, so large containers are not cached.
+static constexpr size_t BATCH = 1024;
+
+// (key, value) pairs of the container in insertion order
+template<typename Key>
+std::vector<std::pair<typename KeyTraits<Key>::Type, Value>> make_entries(size_t count) {
+    auto keys = make_keys<Key>(count, true);
+    std::vector<std::pair<typename KeyTraits<Key>::Type, Value>> entries;
+    entries.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        entries.emplace_back(std::move(keys[i]), static_cast<Value>(i));
+    }
+    return entries;
+}
+
+template<typename Container, typename Entries>
+Container make_container(const Entries& entries) {
+    Container container;
+    container.insert(entries.begin(), entries.end());
+    return container;
+}
+
+// Register Bench for every container and key type (see containers/common.h)
+template<template<template<typename> class, typename> class Bench>
+bool register_all(const std::string& operation) {
+    return register_suite<Bench, Containers>(operation, Keys{});
+}
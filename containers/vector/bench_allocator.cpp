@@ -0,0 +1,323 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// Boost pool allocators
+#include <boost/pool/pool_alloc.hpp>
+#include <boost/pool/singleton_pool.hpp>
+
+#include "common.h"
+
+// Thread sweep: max_threads()
+#include "../../common/threads.h"
+
+// =============================================================================
+// Bump Arena
+// =============================================================================
+
+// Request-scoped arena: allocation bumps an offset, deallocation is a no-op and
+// reset() frees everything at once
+class BumpArena {
+public:
+    explicit BumpArena(size_t capacity) : buffer_(new std::byte[capacity]), capacity_(capacity) {}
+
+    void* allocate(size_t bytes, size_t alignment) {
+        size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes > capacity_) {
+            throw std::bad_alloc();
+        }
+        used_ = offset + bytes;
+        return buffer_.get() + offset;
+    }
+
+    void reset() { used_ = 0; }
+
+private:
+    std::unique_ptr<std::byte[]> buffer_;
+    size_t capacity_;
+    size_t used_ = 0;
+};
+
+// Standard allocator over a BumpArena (stateful, not default constructible)
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(BumpArena& arena) : arena_(&arena) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena_ == other.arena_; }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena_ != other.arena_; }
+
+private:
+    template<typename U>
+    friend class ArenaAllocator;
+
+    BumpArena* arena_;
+};
+
+// Largest insert: 1024 elements
+static constexpr size_t ALLOC_MAX_ELEMENTS = 1024;
+
+// Enough for the largest insert: 1024 x LargeStruct grown by doubling (~512KB)
+static constexpr size_t ARENA_BYTES = 1024 * 1024;
+
+// =============================================================================
+// Allocation Strategies (vector insert)
+// =============================================================================
+// Each strategy makes an empty vector bound to its allocator and is reset after
+// every iteration, once the vector is gone.
+
+// Global operator new/delete (glibc malloc)
+struct StdAlloc {
+    static constexpr const char* name = "Std";
+
+    template<typename T>
+    std::vector<T> make() { return {}; }
+    void reset() {}
+};
+
+// Monotonic buffer over a preallocated block: frees are no-ops, release() rewinds
+struct PmrMonotonic {
+    static constexpr const char* name = "PmrMonotonic";
+
+    std::unique_ptr<std::byte[]> buffer{new std::byte[ARENA_BYTES]};
+    std::pmr::monotonic_buffer_resource resource{buffer.get(), ARENA_BYTES};
+
+    template<typename T>
+    std::pmr::vector<T> make() { return std::pmr::vector<T>(&resource); }
+    void reset() { resource.release(); }
+};
+
+// Size-class pools kept across iterations: freed blocks are reused by the next vector
+struct PmrPool {
+    static constexpr const char* name = "PmrPool";
+
+    std::pmr::unsynchronized_pool_resource resource;
+
+    template<typename T>
+    std::pmr::vector<T> make() { return std::pmr::vector<T>(&resource); }
+    void reset() {}
+};
+
+// Bump arena through a regular allocator type: no virtual call per allocation
+struct Arena {
+    static constexpr const char* name = "Arena";
+
+    BumpArena arena{ARENA_BYTES};
+
+    template<typename T>
+    std::vector<T, ArenaAllocator<T>> make() { return std::vector<T, ArenaAllocator<T>>(ArenaAllocator<T>(arena)); }
+    void reset() { arena.reset(); }
+};
+
+// boost::pool_allocator: one mutex-protected singleton pool per element size,
+// contiguous runs of n chunks for each vector buffer (ordered_malloc)
+struct BoostPool {
+    static constexpr const char* name = "BoostPool";
+
+    template<typename T>
+    std::vector<T, boost::pool_allocator<T>> make() { return {}; }
+    void reset() {}
+};
+
+// Strategy as a kind of the benchmark generator (common.h): type<Element> is the
+// strategy itself, sizes stop at ALLOC_MAX_ELEMENTS
+template<typename Strategy>
+struct AllocKind {
+    static constexpr const char* name = Strategy::name;
+    static constexpr size_t capacity = ALLOC_MAX_ELEMENTS;
+    template<typename T> using type = Strategy;
+};
+
+using Strategies = TypeList<AllocKind<StdAlloc>, AllocKind<PmrMonotonic>, AllocKind<PmrPool>, AllocKind<Arena>,
+                            AllocKind<BoostPool>>;
+
+// =============================================================================
+// INSERT Benchmarks (same pattern as bench_insert.cpp, allocator varies)
+// =============================================================================
+// Names: AllocInsert/<Element>/<Allocator>/<Size>, e.g. AllocInsert/int/PmrMonotonic/64
+
+template<typename Strategy, typename Element>
+struct AllocInsert {
+    static void run(benchmark::State& state) {
+        const int count = static_cast<int>(state.range(0));
+        Strategy strategy;
+        for (auto _ : state) {
+            {
+                auto vec = strategy.template make<Element>();
+                for (int i = 0; i < count; ++i) {
+                    vec.push_back(Element(i));
+                }
+                benchmark::DoNotOptimize(vec.data());
+                benchmark::ClobberMemory();
+            }
+            strategy.reset();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+};
+
+static const bool registered_insert = register_benchmarks<AllocInsert>("AllocInsert", Strategies{}, Elements{});
+
+// =============================================================================
+// Multithreaded Churn
+// =============================================================================
+// Every thread serves "requests": allocate REQUEST_BLOCKS blocks of mixed sizes, fill
+// them, free them in random order. Thread-local strategies are plain locals of the
+// benchmark function (each thread runs it); shared ones are statics.
+
+static constexpr size_t REQUEST_BLOCKS = 64;
+static constexpr size_t SIZE_CLASSES[] = {16, 32, 64, 128, 256};
+
+// Per-thread request buffer (REQUEST_BLOCKS x 256B fits many times over)
+static constexpr size_t REQUEST_ARENA_BYTES = 64 * 1024;
+
+// glibc malloc: per-thread caches (tcache) and arenas
+struct MallocChurn {
+    static constexpr const char* name = "Malloc";
+
+    void* allocate(size_t bytes) { return ::operator new(bytes); }
+    void deallocate(void* p, size_t) { ::operator delete(p); }
+    void end_request() {}
+};
+
+// Per-thread monotonic buffer, rewound after each request
+struct PmrMonotonicChurn {
+    static constexpr const char* name = "PmrMonotonic";
+
+    std::unique_ptr<std::byte[]> buffer{new std::byte[REQUEST_ARENA_BYTES]};
+    std::pmr::monotonic_buffer_resource resource{buffer.get(), REQUEST_ARENA_BYTES};
+
+    void* allocate(size_t bytes) { return resource.allocate(bytes); }
+    void deallocate(void* p, size_t bytes) { resource.deallocate(p, bytes); }
+    void end_request() { resource.release(); }
+};
+
+// Per-thread pools, no locking
+struct PmrUnsyncPoolChurn {
+    static constexpr const char* name = "PmrUnsyncPool";
+
+    std::pmr::unsynchronized_pool_resource resource;
+
+    void* allocate(size_t bytes) { return resource.allocate(bytes); }
+    void deallocate(void* p, size_t bytes) { resource.deallocate(p, bytes); }
+    void end_request() {}
+};
+
+// One pool resource shared by all threads (internally locked)
+static std::pmr::synchronized_pool_resource shared_pool;
+
+struct PmrSyncPoolChurn {
+    static constexpr const char* name = "PmrSyncPool";
+
+    void* allocate(size_t bytes) { return shared_pool.allocate(bytes); }
+    void deallocate(void* p, size_t bytes) { shared_pool.deallocate(p, bytes); }
+    void end_request() {}
+};
+
+// Per-thread bump arena, reset after each request
+struct ArenaChurn {
+    static constexpr const char* name = "Arena";
+
+    BumpArena arena{REQUEST_ARENA_BYTES};
+
+    void* allocate(size_t bytes) { return arena.allocate(bytes, alignof(std::max_align_t)); }
+    void deallocate(void*, size_t) {}
+    void end_request() { arena.reset(); }
+};
+
+// boost::singleton_pool per size class: shared by all threads, one mutex each
+struct ChurnPoolTag {};
+template<size_t Size>
+using ChurnPool = boost::singleton_pool<ChurnPoolTag, Size>;
+
+struct BoostPoolChurn {
+    static constexpr const char* name = "BoostPool";
+
+    void* allocate(size_t bytes) {
+        switch (bytes) {
+            case 16:  return ChurnPool<16>::malloc();
+            case 32:  return ChurnPool<32>::malloc();
+            case 64:  return ChurnPool<64>::malloc();
+            case 128: return ChurnPool<128>::malloc();
+            default:  return ChurnPool<256>::malloc();
+        }
+    }
+    void deallocate(void* p, size_t bytes) {
+        switch (bytes) {
+            case 16:  ChurnPool<16>::free(p); break;
+            case 32:  ChurnPool<32>::free(p); break;
+            case 64:  ChurnPool<64>::free(p); break;
+            case 128: ChurnPool<128>::free(p); break;
+            default:  ChurnPool<256>::free(p); break;
+        }
+    }
+    void end_request() {}
+};
+
+// Reports 'allocations' per second, summed over all threads
+template<typename Strategy>
+static void BM_Churn(benchmark::State& state) {
+    Strategy strategy;
+
+    // Same request shape every iteration, different per thread
+    std::mt19937 gen(static_cast<unsigned>(state.thread_index()) + 1);
+    std::uniform_int_distribution<size_t> dis(0, std::size(SIZE_CLASSES) - 1);
+    std::array<size_t, REQUEST_BLOCKS> sizes;
+    for (size_t& size : sizes) {
+        size = SIZE_CLASSES[dis(gen)];
+    }
+    std::array<size_t, REQUEST_BLOCKS> free_order;
+    std::iota(free_order.begin(), free_order.end(), 0);
+    std::shuffle(free_order.begin(), free_order.end(), gen);
+    std::array<void*, REQUEST_BLOCKS> blocks;
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < REQUEST_BLOCKS; ++i) {
+            blocks[i] = strategy.allocate(sizes[i]);
+            std::memset(blocks[i], static_cast<int>(i), sizes[i]);
+        }
+        benchmark::DoNotOptimize(blocks.data());
+        benchmark::ClobberMemory();
+        for (size_t i : free_order) {
+            strategy.deallocate(blocks[i], sizes[i]);
+        }
+        strategy.end_request();
+    }
+    state.counters["allocations"] = benchmark::Counter(static_cast<double>(REQUEST_BLOCKS),
+                                                       benchmark::Counter::kIsIterationInvariantRate);
+}
+
+using ChurnStrategies = TypeList<MallocChurn, PmrMonotonicChurn, PmrUnsyncPoolChurn, PmrSyncPoolChurn, ArenaChurn,
+                                 BoostPoolChurn>;
+
+// Churn/<Allocator>, swept over 1, 2, 4, ... threads
+template<typename... Strategies>
+bool register_churn(TypeList<Strategies...>) {
+    (benchmark::RegisterBenchmark((std::string("Churn/") + Strategies::name).c_str(), BM_Churn<Strategies>)
+         ->ThreadRange(1, max_threads())
+         ->UseRealTime(),
+     ...);
+    return true;
+}
+
+static const bool registered_churn = register_churn(ChurnStrategies{});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,28 @@
+#include "common.h"
+
+// =============================================================================
+// ERASE Benchmarks
+// =============================================================================
+// EraseMiddle: erase the middle element of a container of N elements (shifting the
+// back half down by one) and push_back a replacement, so the size stays N
+
+template<typename Container, typename Element>
+struct EraseMiddle {
+    static void run(benchmark::State& state) {
+        const size_t count = static_cast<size_t>(state.range(0));
+        Container vec = make_filled<Container, Element>(count);
+        const Element replacement(static_cast<int>(count));
+
+        for (auto _ : state) {
+            vec.erase(vec.begin() + static_cast<std::ptrdiff_t>(count / 2));
+            vec.push_back(replacement);
+            benchmark::DoNotOptimize(vec.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+};
+
+static const bool registered = register_benchmarks<EraseMiddle>("EraseMiddle");
+
+BENCHMARK_MAIN();
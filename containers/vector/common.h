@@ -1,6 +1,23 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+// Boost containers
+#include <boost/container/vector.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
+
+// Abseil container
+#include <absl/container/inlined_vector.h>
+
+// TypeList (shared with containers/hashmap and containers/ordered)
+#include "../common.h"
 
 // =============================================================================
 // Common Data Structures for Container Benchmarks
@@ -22,3 +39,109 @@ struct LargeStruct {
     LargeStruct() { data.fill(0); }
     explicit LargeStruct(int val) { data.fill(val); }
 };
+
+// Element owning heap memory: 32 characters, past the small-string buffer, so a copy
+// allocates and a move only takes the pointer
+struct HeapString {
+    std::string text;
+    HeapString() = default;
+    explicit HeapString(int val) : text(32, static_cast<char>('a' + val % 26)) {}
+};
+
+// =============================================================================
+// Benchmark Generator
+// =============================================================================
+// Every operation is registered for each container kind x element type in the type
+// lists below, sized with RangeMultiplier(4)->Range(1, max): 1, 4, 16, ... elements.
+// Names are <Operation>/<Element>/<Container>/<Size>, e.g. Insert/int/SmallVector/64;
+// generate_summary.py groups them per operation, element and size.
+
+// Inline capacity of small_vector / InlinedVector: sizes up to 16 stay inline, 64 and
+// above spill to the heap
+static constexpr size_t INLINE_CAPACITY = 16;
+
+// Fixed capacity of static_vector (its sizes stop there)
+static constexpr size_t STATIC_CAPACITY = 1024;
+
+// Upper end of the size range: 1M elements, at most 64MB per container
+static constexpr size_t MAX_ELEMENTS = 1024 * 1024;
+static constexpr size_t MAX_BYTES = 64 * 1024 * 1024;
+
+struct StdVectorKind {
+    static constexpr const char* name = "StdVector";
+    static constexpr size_t capacity = MAX_ELEMENTS;
+    template<typename T> using type = std::vector<T>;
+};
+
+struct BoostVectorKind {
+    static constexpr const char* name = "BoostVector";
+    static constexpr size_t capacity = MAX_ELEMENTS;
+    template<typename T> using type = boost::container::vector<T>;
+};
+
+struct SmallVectorKind {
+    static constexpr const char* name = "SmallVector";
+    static constexpr size_t capacity = MAX_ELEMENTS;
+    template<typename T> using type = boost::container::small_vector<T, INLINE_CAPACITY>;
+};
+
+struct StaticVectorKind {
+    static constexpr const char* name = "StaticVector";
+    static constexpr size_t capacity = STATIC_CAPACITY;
+    template<typename T> using type = boost::container::static_vector<T, STATIC_CAPACITY>;
+};
+
+struct InlinedVectorKind {
+    static constexpr const char* name = "InlinedVector";
+    static constexpr size_t capacity = MAX_ELEMENTS;
+    template<typename T> using type = absl::InlinedVector<T, INLINE_CAPACITY>;
+};
+
+using Containers = TypeList<StdVectorKind, BoostVectorKind, SmallVectorKind, StaticVectorKind, InlinedVectorKind>;
+using Elements = TypeList<SmallElement, Point, LargeStruct, HeapString>;
+
+template<typename Element> struct ElementName;
+template<> struct ElementName<SmallElement> { static constexpr const char* name = "int"; };
+template<> struct ElementName<Point> { static constexpr const char* name = "Point"; };
+template<> struct ElementName<LargeStruct> { static constexpr const char* name = "LargeStruct"; };
+template<> struct ElementName<HeapString> { static constexpr const char* name = "String"; };
+
+// Container of `count` elements Element(0), Element(1), ...
+template<typename Container, typename Element>
+Container make_filled(size_t count) {
+    Container vec;
+    for (size_t i = 0; i < count; ++i) {
+        vec.push_back(Element(static_cast<int>(i)));
+    }
+    return vec;
+}
+
+// A benchmark is a class template Bench<Container, Element> with a static
+// run(benchmark::State&) that reads the element count from state.range(0)
+template<template<typename, typename> class Bench, typename Kind, typename Element>
+void register_benchmark(const std::string& operation) {
+    const size_t max_size = std::min({Kind::capacity, MAX_ELEMENTS, MAX_BYTES / sizeof(Element)});
+    std::string name = operation + "/" + ElementName<Element>::name + "/" + Kind::name;
+    benchmark::RegisterBenchmark(name.c_str(), Bench<typename Kind::template type<Element>, Element>::run)
+        ->RangeMultiplier(4)
+        ->Range(1, static_cast<int64_t>(max_size));
+}
+
+template<template<typename, typename> class Bench, typename Element, typename... Kinds>
+void register_element(const std::string& operation, TypeList<Kinds...>) {
+    (register_benchmark<Bench, Kinds, Element>(operation), ...);
+}
+
+// Register Bench for every kind of Kinds (a TypeList of kinds with name, capacity and
+// type<Element>, e.g. Containers) and every element type
+template<template<typename, typename> class Bench, typename Kinds, typename... ElementTypes>
+bool register_benchmarks(const std::string& operation, Kinds kinds, TypeList<ElementTypes...>) {
+    (register_element<Bench, ElementTypes>(operation, kinds), ...);
+    return true;
+}
+
+// Register Bench for every container kind and element type
+template<template<typename, typename> class Bench>
+bool register_benchmarks(const std::string& operation) {
+    return register_benchmarks<Bench>(operation, Containers{}, Elements{});
+}
@@ -14,92 +14,77 @@ fi
 
 PROJECT_NAME="$1"
 PROJECT_DIR="${SCRIPT_DIR}/${PROJECT_NAME}"
-BUILD_BASE_DIR="${SCRIPT_DIR}/.build"
-DISASM_DIR="${SCRIPT_DIR}/.disassembly/${PROJECT_NAME}"
+# For nested projects (e.g., containers/vector), use the last component as binary name
+BINARY_NAME=$(basename "${PROJECT_NAME}")
+# Replace slashes with underscores for directory names
+SAFE_PROJECT_NAME="${PROJECT_NAME//\//_}"
+DISASM_DIR="${SCRIPT_DIR}/.disassembly/${SAFE_PROJECT_NAME}"
 
 if [ ! -d "${PROJECT_DIR}" ]; then
     echo "Error: Project directory ${PROJECT_DIR} does not exist"
     exit 1
 fi
 
-COMPILERS=("clang" "gcc")
-OPT_LEVELS=("O0" "O1" "O2" "O3")
-
 mkdir -p "${DISASM_DIR}"
 
 echo "============================================"
 echo "Starting disassembly runs for project: ${PROJECT_NAME}"
 echo "Compilers: ${COMPILERS[@]}"
 echo "Optimization levels: ${OPT_LEVELS[@]}"
+echo "Flag profiles: ${PERFECTION_PROFILES:-none}"
 echo "============================================"
 echo ""
 
+# Reuses the builds from benchmarks.sh; only changed configurations are rebuilt
+if [ -z "${PERFECTION_SKIP_BUILD}" ]; then
+    build_matrix "${SCRIPT_DIR}" "${PROJECT_NAME}"
+fi
+
 for compiler in "${COMPILERS[@]}"; do
-    for opt_level in "${OPT_LEVELS[@]}"; do
-        BUILD_DIR="${BUILD_BASE_DIR}/${PROJECT_NAME}/${compiler}_${opt_level}"
-        EXECUTABLE="${BUILD_DIR}/${PROJECT_NAME}"
+    for opt_level in $(config_opt_levels "${compiler}"); do
+        BUILD_DIR=$(config_build_dir "${SCRIPT_DIR}" "${PROJECT_NAME}" "${compiler}" "${opt_level}")
         DISASM_FILE="${DISASM_DIR}/${compiler}_${opt_level}.dis"
         
-        echo "============================================"
-        echo "Building ${PROJECT_NAME} with ${compiler} -${opt_level}..."
-        echo "Build dir: ${BUILD_DIR}"
-        echo "============================================"
-        
-        build_project "${PROJECT_DIR}" "${BUILD_DIR}" "${compiler}" "${opt_level}"
-        
-        echo ""
         echo "============================================"
         echo "Disassembling with ${compiler} -${opt_level}..."
         echo "============================================"
         
-        objdump -d -C "${EXECUTABLE}" > "${DISASM_DIR}/full_${compiler}_${opt_level}.dis"
-        
         > "${DISASM_FILE}"
         
         echo "Project: ${PROJECT_NAME}" >> "${DISASM_FILE}"
         echo "Compiler: ${compiler}" >> "${DISASM_FILE}"
         echo "Optimization: -${opt_level}" >> "${DISASM_FILE}"
+        PROFILE_FLAGS=$(opt_level_flags "${compiler}" "${opt_level}")
+        if [ -n "${PROFILE_FLAGS}" ]; then
+            echo "Profile flags: ${PROFILE_FLAGS}" >> "${DISASM_FILE}"
+        fi
         echo "" >> "${DISASM_FILE}"
         
-        # Extract functions with prfct_ in the name (both regular and template functions)
-        FUNCTIONS=$(grep -E '^[0-9a-f]+ <.*prfct_.*>' "${DISASM_DIR}/full_${compiler}_${opt_level}.dis" | \
-                    sed 's/^[0-9a-f]\+ <\(.*\)>:/\1/')
-        
-        # Extract each relevant function
-        while IFS= read -r funcname; do
-            if [ -n "$funcname" ]; then
-                echo "========== $funcname ==========" >> "${DISASM_FILE}"
-                # Read file line by line, extract from function start to empty line
-                in_function=0
-                while IFS= read -r line; do
-                    if [[ "$line" == *"<${funcname}>:"* ]]; then
-                        in_function=1
-                    fi
-                    if [ $in_function -eq 1 ]; then
-                        echo "$line" | sed 's/^[ ]*[0-9a-f]\+://' >> "${DISASM_FILE}"
-                        if [ -z "$line" ]; then
-                            break
-                        fi
-                    fi
-                done < "${DISASM_DIR}/full_${compiler}_${opt_level}.dis"
-                echo "" >> "${DISASM_FILE}"
-            fi
-        done <<< "$FUNCTIONS"
-        
-        rm "${DISASM_DIR}/full_${compiler}_${opt_level}.dis"
+        # Every binary of the configuration (several for split suites, see perfection_add_benchmark)
+        for EXECUTABLE in $(config_binaries "${BUILD_DIR}" "${BINARY_NAME}"); do
+            echo "Binary: $(basename "${EXECUTABLE}")" >> "${DISASM_FILE}"
+            echo "" >> "${DISASM_FILE}"
+            
+            # Functions with prfct_ in the name (both regular and template functions),
+            # with code size, instruction count and loops per function
+            python3 "${SCRIPT_DIR}/extract_disassembly.py" "${EXECUTABLE}" >> "${DISASM_FILE}"
+        done
         
         echo "Saved to: ${DISASM_FILE}"
         echo ""
     done
 done
 
+# Instruction mix of every prfct_ function next to its measured time (.disassembly/<project>/report.md)
+python3 "${SCRIPT_DIR}/disassembly_report.py" "${PROJECT_NAME}"
+
 echo "============================================"
 echo "Done! Disassembly files saved to: ${DISASM_DIR}/"
 echo "============================================"
 echo ""
 echo "Generated files:"
 for compiler in "${COMPILERS[@]}"; do
-    for opt_level in "${OPT_LEVELS[@]}"; do
+    for opt_level in $(config_opt_levels "${compiler}"); do
         echo "  - ${compiler}_${opt_level}.dis"
     done
 done
@@ -107,4 +92,4 @@ echo ""
 echo "To view a specific disassembly:"
 echo "  cat ${DISASM_DIR}/clang_O3.dis"
 echo "  or"
-echo "  less ${DISASM_DIR}/${PROJECT_NAME}_gcc_O2.dis"
+echo "  less ${DISASM_DIR}/gcc_O2.dis"
@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+"""
+Correlate the code of prfct_ functions with measured performance.
+
+For every configuration of a project, classifies the instructions of each prfct_ function
+(vector width, calls, branches, memory accesses) and puts them next to the CPU time and
+counters of the matching benchmark from .benchmarks/results.json:
+
+    ## prfct_swap_sequential(...)
+    | Config   | Benchmark     | Time     | IPC  | Instr | Loops | SSE | AVX | AVX-512 | Calls | ...
+    | gcc_O3   | BM_sequential | 1204 ns  | 3.10 |    42 |     1 |   0 |  12 |       0 |     0 | ...
+    | clang_O3 | BM_sequential | 3810 ns  | 2.05 |    18 |     1 |   0 |   0 |       0 |     0 | ...
+
+Benchmarks are matched to functions by name tokens (BM_process_inlined ~ prfct_process_random_data_inlined),
+best effort; functions without a matching benchmark show '-'.
+
+Output: .disassembly/<project>/report.md
+
+Usage:
+    python3 disassembly_report.py <project_name>
+"""
+
+import re
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional
+
+from extract_disassembly import extract_functions, find_loops
+from generate_summary import format_time, order_config_names
+from perfection_results import STORE_NAME, load_store, measured_time_ns, median
+
+
+ROOT_DIR = Path(__file__).parent
+
+# AT&T syntax: memory operands are '(%reg...)' or 'symbol(%rip)'
+MEMORY_OPERAND_RE = re.compile(r'\(')
+
+# Instructions that address memory without accessing it
+NO_ACCESS_MNEMONICS = ('lea', 'nop', 'prefetch', 'endbr')
+
+# Scalar floating point in SSE/AVX registers (addss, vmulsd, cvtsi2sd, ucomisd, ...);
+# packed integer instructions (p*: pminsd, ...) are excluded before matching
+SCALAR_FP_RE = re.compile(r'(s[sd]$|^cvts|^u?comis)')
+
+REPORT_COLUMNS = ['Instr', 'Loops', 'Scalar FP', 'SSE', 'AVX', 'AVX-512',
+                  'Calls', 'Indirect', 'Branches', 'Loads', 'Stores']
+
+
+def split_operands(operands: str) -> List[str]:
+    """Split AT&T operands on top-level commas: '0x8(%rax,%rbx,4),%ecx' -> ['0x8(%rax,%rbx,4)', '%ecx']."""
+    # Drop objdump's trailing comment ('# 40c0 <random_data>') and symbolic target ('<foo+0x10>')
+    operands = operands.split('#')[0].split('<')[0].strip()
+    parts, depth, current = [], 0, ''
+    for char in operands:
+        if char == ',' and depth == 0:
+            parts.append(current)
+            current = ''
+            continue
+        depth += char == '('
+        depth -= char == ')'
+        current += char
+    if current:
+        parts.append(current)
+    return [p.strip() for p in parts]
+
+
+def classify(function: Dict) -> Dict[str, int]:
+    """
+    Instruction mix of one function (alignment padding excluded).
+    
+    Vector instructions are counted by their widest register: xmm (SSE/AVX-128), ymm (AVX),
+    zmm (AVX-512); scalar FP (ss/sd suffix) counts separately. A memory destination is
+    a store (plus a load for read-modify-write), any other memory operand a load.
+    """
+    mix = dict.fromkeys(REPORT_COLUMNS, 0)
+    mix['Instr'] = len(function['instructions'])
+    mix['Loops'] = len(find_loops(function))
+    
+    for _, mnemonic, operands in function['instructions']:
+        # 'lock', 'rep', 'notrack', 'bnd' prefixes: classify the instruction itself
+        if mnemonic in ('lock', 'rep', 'repz', 'repnz', 'notrack', 'bnd', 'data16', 'cs', 'ds'):
+            mnemonic, _, operands = operands.partition(' ')
+            operands = operands.strip()
+        
+        if mnemonic.startswith('call'):
+            mix['Calls'] += 1
+            mix['Indirect'] += operands.startswith('*')
+            continue
+        if mnemonic.startswith('j') or mnemonic.startswith('loop'):
+            mix['Branches'] += 1
+            mix['Indirect'] += operands.startswith('*')
+            continue
+        
+        if '%zmm' in operands:
+            mix['AVX-512'] += 1
+        elif '%ymm' in operands:
+            mix['AVX'] += 1
+        elif '%xmm' in operands:
+            base = mnemonic[1:] if mnemonic.startswith('v') else mnemonic
+            if not base.startswith('p') and SCALAR_FP_RE.search(base):
+                mix['Scalar FP'] += 1
+            else:
+                mix['SSE'] += 1
+        
+        if mnemonic.startswith(NO_ACCESS_MNEMONICS):
+            continue
+        if mnemonic.startswith('push'):
+            mix['Stores'] += 1
+            continue
+        if mnemonic.startswith('pop'):
+            mix['Loads'] += 1
+            continue
+        
+        parts = split_operands(operands)
+        memory = [i for i, part in enumerate(parts) if MEMORY_OPERAND_RE.search(part)]
+        if not memory:
+            continue
+        # AT&T: destination is the last operand
+        if memory[-1] == len(parts) - 1 and len(parts) > 1:
+            mix['Stores'] += 1
+            if not mnemonic.startswith(('mov', 'vmov', 'set', 'stos')) or len(memory) > 1:
+                mix['Loads'] += 1
+        else:
+            mix['Loads'] += 1
+    return mix
+
+
+def name_tokens(name: str) -> set:
+    """
+    Words and numeric arguments of a function or benchmark name.
+    
+    Input: 'void prfct_swap_unrolled<16ul>()' / 'BM_unrolled/16'
+    Output: {'swap', 'unrolled', '16'} / {'unrolled', '16'}
+    """
+    tokens = set()
+    for token in re.split(r'[^A-Za-z0-9]+', name.split('(')[0].lower()):
+        # Template arguments carry integer suffixes: 16ul -> 16
+        number = re.fullmatch(r'(\d+)[ul]*', token)
+        if number:
+            tokens.add(number.group(1))
+        elif token and token not in ('prfct', 'bm', 'void'):
+            tokens.add(token)
+    return tokens
+
+
+def match_benchmark(function_name: str, benchmarks: List[str]) -> Optional[str]:
+    """Benchmark sharing the most name tokens with the function (ties: fewest extra tokens)."""
+    tokens = name_tokens(function_name)
+    best, best_score = None, (0, 0)
+    for bench in sorted(benchmarks):
+        bench_tokens = name_tokens(bench)
+        score = (len(tokens & bench_tokens), -len(bench_tokens - tokens))
+        if score[0] > 0 and score > best_score:
+            best, best_score = bench, score
+    return best
+
+
+def load_measurements(project: str) -> Dict[str, Dict[str, Dict]]:
+    """Median CPU time and IPC per config and benchmark: {config: {benchmark: {'time', 'ipc'}}}."""
+    store_path = ROOT_DIR / '.benchmarks' / STORE_NAME
+    if not store_path.exists():
+        return {}
+    
+    samples = {}
+    for record in load_store(store_path, project):
+        entry = samples.setdefault(record['config'], {}).setdefault(record['benchmark'], {'time': [], 'ipc': []})
+        entry['time'].append(measured_time_ns(record))
+        counters = record.get('counters', {})
+        if counters.get('CYCLES') and 'INSTRUCTIONS' in counters:
+            entry['ipc'].append(counters['INSTRUCTIONS'] / counters['CYCLES'])
+    
+    return {
+        config: {
+            bench: {'time': median(v['time']), 'ipc': median(v['ipc']) if v['ipc'] else None}
+            for bench, v in benchmarks.items()
+        }
+        for config, benchmarks in samples.items()
+    }
+
+
+def config_binaries(build_dir: Path, binary_name: str) -> List[Path]:
+    """Benchmark binaries of a configuration (same rules as config_binaries in build_common.sh)."""
+    manifest = build_dir / 'perfection_benchmarks.txt'
+    if manifest.exists():
+        return [build_dir / name for name in manifest.read_text().split()]
+    bench_binaries = sorted(build_dir.glob('bench_*'))
+    return bench_binaries or [build_dir / binary_name]
+
+
+def format_table(header: List[str], rows: List[List[str]]) -> str:
+    """Markdown table, first two columns left-aligned, numbers right-aligned."""
+    widths = [max(len(header[i]), *(len(row[i]) for row in rows)) for i in range(len(header))]
+    lines = ["| " + " | ".join(h.ljust(w) for h, w in zip(header, widths)) + " |"]
+    lines.append("|" + "|".join("-" * (w + 2) for w in widths) + "|")
+    for row in rows:
+        cells = [cell.ljust(w) if i < 2 else cell.rjust(w) for i, (cell, w) in enumerate(zip(row, widths))]
+        lines.append("| " + " | ".join(cells) + " |")
+    return "\n".join(lines) + "\n"
+
+
+def generate_report(project: str) -> str:
+    """Markdown report: one table per prfct_ function, one row per configuration."""
+    # Builds and results of nested projects (containers/vector) live under containers_vector
+    safe_name = project.replace('/', '_')
+    build_root = ROOT_DIR / '.build' / safe_name
+    measurements = load_measurements(safe_name)
+    
+    # {function label: {config: (function, mix)}}
+    functions = {}
+    config_dirs = {d.name: d for d in build_root.iterdir() if d.is_dir()} if build_root.is_dir() else {}
+    for config, build_dir in config_dirs.items():
+        binaries = [b for b in config_binaries(build_dir, Path(project).name) if b.exists()]
+        for binary in binaries:
+            for function in extract_functions(str(binary)):
+                label = function['name'] if len(binaries) == 1 else f"{binary.name}: {function['name']}"
+                functions.setdefault(label, {})[config] = function
+    
+    # Columns ordered like summary.md: highest optimization first
+    configs = order_config_names(config_dirs)
+    
+    md = f"# Disassembly Report: {project}\n\n"
+    md += "Instruction mix of each `prfct_` function per configuration, next to the matching benchmark.\n"
+    md += "Vector columns count instructions by widest register (SSE: xmm, AVX: ymm, AVX-512: zmm).\n\n"
+    if not functions:
+        return md + "No `prfct_` functions found (build the project first).\n"
+    
+    header = ['Config', 'Benchmark', 'Time', 'IPC'] + REPORT_COLUMNS
+    for label in sorted(functions):
+        rows = []
+        for config in configs:
+            function = functions[label].get(config)
+            if function is None:
+                continue
+            benchmarks = measurements.get(config, {})
+            bench = match_benchmark(function['name'], list(benchmarks))
+            measured = benchmarks.get(bench, {})
+            mix = classify(function)
+            rows.append([
+                config,
+                bench or '-',
+                format_time(measured['time']) if measured else '-',
+                f"{measured['ipc']:.2f}" if measured.get('ipc') is not None else '-',
+            ] + [str(mix[column]) for column in REPORT_COLUMNS])
+        md += f"## {label}\n\n" + format_table(header, rows) + "\n"
+    return md
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(f"Usage: {sys.argv[0]} <project_name>")
+        print(f"Example: {sys.argv[0]} ilp_no_data_dependencies")
+        sys.exit(1)
+    
+    project = sys.argv[1]
+    report = generate_report(project)
+    
+    output_dir = ROOT_DIR / '.disassembly' / project.replace('/', '_')
+    output_dir.mkdir(parents=True, exist_ok=True)
+    output_path = output_dir / 'report.md'
+    with open(output_path, 'w') as f:
+        f.write(report)
+    
+    print(f"✓ Generated: {output_path}")
+
+
+if __name__ == "__main__":
+    main()
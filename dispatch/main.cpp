@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+// Polymorphic collections of N concrete types (2, 4, 16), summed by calling each
+// element's eval(). Every dispatch strategy sees the same elements in the same order:
+// - Sorted: one collection ordered by type (long runs of one target, well predicted)
+// - Shuffled: one collection in random type order (megamorphic, mispredicted at N > 2)
+// - Partitioned: one collection per type, walked one after another (each loop is
+//   monomorphic; only here can the type be known statically, which CRTP needs)
+
+// Elements per collection
+static constexpr size_t COUNT = 16 * 1024;
+
+// ========== CONCRETE TYPES ==========
+// Shape<K> differ only in their constants, so each has its own eval() body
+
+template <int K>
+struct Shape {
+    float a, b;
+    float eval() const { return a * static_cast<float>(K + 1) + b / static_cast<float>(K + 2); }
+};
+
+// Type index and operands of each element
+struct Element {
+    uint8_t type;
+    float a, b;
+};
+
+enum class Order { Sorted, Shuffled, Partitioned };
+
+std::vector<Element> make_elements(int types, Order order) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> type(0, types - 1);
+    std::uniform_real_distribution<float> operand(0.0f, 1.0f);
+    std::vector<Element> elements(COUNT);
+    for (Element& element : elements) {
+        element = {static_cast<uint8_t>(type(gen)), operand(gen), operand(gen)};
+    }
+    if (order != Order::Shuffled) {
+        std::stable_sort(elements.begin(), elements.end(),
+                         [](const Element& x, const Element& y) { return x.type < y.type; });
+    }
+    return elements;
+}
+
+// Calls f(std::integral_constant<int, K>{}) for the runtime index type < N
+template <int N, typename F, int... K>
+decltype(auto) with_type(int type, F&& f, std::integer_sequence<int, K...>) {
+    using R = decltype(f(std::integral_constant<int, 0>{}));
+    static constexpr R (*table[])(F&) = {[](F& g) -> R { return g(std::integral_constant<int, K>{}); }...};
+    return table[type](f);
+}
+
+template <int N, typename F>
+decltype(auto) with_type(int type, F&& f) {
+    return with_type<N>(type, f, std::make_integer_sequence<int, N>{});
+}
+
+// std::tuple<std::vector<T<0>>, ..., std::vector<T<N-1>>>: objects stored per type
+template <template <int> class T, typename Sequence>
+struct PerTypeVectors;
+
+template <template <int> class T, int... K>
+struct PerTypeVectors<T, std::integer_sequence<int, K...>> {
+    using type = std::tuple<std::vector<T<K>>...>;
+};
+
+template <template <int> class T, int N>
+using PerType = typename PerTypeVectors<T, std::make_integer_sequence<int, N>>::type;
+
+// ========== VIRTUAL ==========
+// Heap-allocated objects behind base pointers (the plugin-interface layout)
+
+struct VirtualBase {
+    virtual ~VirtualBase() = default;
+    virtual float eval() const = 0;
+};
+
+template <int K>
+struct VirtualShape final : VirtualBase {
+    Shape<K> shape;
+    explicit VirtualShape(Shape<K> s) : shape(s) {}
+    float eval() const override { return shape.eval(); }
+};
+
+template <int N>
+struct Virtual {
+    using Collection = std::vector<std::unique_ptr<VirtualBase>>;
+
+    static Collection build(const std::vector<Element>& elements) {
+        Collection collection;
+        for (const Element& e : elements) {
+            collection.push_back(with_type<N>(e.type, [&](auto k) -> std::unique_ptr<VirtualBase> {
+                return std::make_unique<VirtualShape<k>>(Shape<k>{e.a, e.b});
+            }));
+        }
+        return collection;
+    }
+};
+
+float prfct_sum_virtual(const std::vector<std::unique_ptr<VirtualBase>>& collection) {
+    float sum = 0.0f;
+    for (const auto& object : collection) {
+        sum += object->eval();
+    }
+    return sum;
+}
+
+// ========== VARIANT ==========
+// Objects stored inline in the vector, std::visit dispatches on the index
+
+template <typename Sequence>
+struct ShapeVariant;
+
+template <int... K>
+struct ShapeVariant<std::integer_sequence<int, K...>> {
+    using type = std::variant<Shape<K>...>;
+};
+
+template <int N>
+struct Variant {
+    using Collection = std::vector<typename ShapeVariant<std::make_integer_sequence<int, N>>::type>;
+
+    static Collection build(const std::vector<Element>& elements) {
+        Collection collection;
+        for (const Element& e : elements) {
+            with_type<N>(e.type, [&](auto k) { collection.emplace_back(Shape<k>{e.a, e.b}); });
+        }
+        return collection;
+    }
+};
+
+template <typename Collection>
+float prfct_sum_variant(const Collection& collection) {
+    float sum = 0.0f;
+    for (const auto& object : collection) {
+        sum += std::visit([](const auto& shape) { return shape.eval(); }, object);
+    }
+    return sum;
+}
+
+// ========== FUNCTION POINTER TABLE ==========
+// Plain structs with a type tag, one table lookup + indirect call per element
+
+template <int K>
+float eval_element(const Element& e) {
+    return Shape<K>{e.a, e.b}.eval();
+}
+
+template <int... K>
+constexpr auto make_eval_table(std::integer_sequence<int, K...>) {
+    return std::array<float (*)(const Element&), sizeof...(K)>{&eval_element<K>...};
+}
+
+template <int N>
+struct FunctionPointer {
+    using Collection = std::vector<Element>;
+
+    static Collection build(const std::vector<Element>& elements) { return elements; }
+};
+
+template <int N>
+float prfct_sum_function_pointer(const std::vector<Element>& collection) {
+    static constexpr auto table = make_eval_table(std::make_integer_sequence<int, N>{});
+    float sum = 0.0f;
+    for (const Element& e : collection) {
+        sum += table[e.type](e);
+    }
+    return sum;
+}
+
+// ========== STD::FUNCTION ==========
+// Lambdas capturing the shape by value (8 bytes: stored in std::function's local buffer)
+
+template <int N>
+struct StdFunction {
+    using Collection = std::vector<std::function<float()>>;
+
+    static Collection build(const std::vector<Element>& elements) {
+        Collection collection;
+        for (const Element& e : elements) {
+            with_type<N>(e.type, [&](auto k) {
+                collection.emplace_back([shape = Shape<k>{e.a, e.b}] { return shape.eval(); });
+            });
+        }
+        return collection;
+    }
+};
+
+float prfct_sum_std_function(const std::vector<std::function<float()>>& collection) {
+    float sum = 0.0f;
+    for (const auto& function : collection) {
+        sum += function();
+    }
+    return sum;
+}
+
+// ========== INPLACE FUNCTION ==========
+// Small-buffer type-erased callable: the callable is copied into a fixed 16-byte buffer
+// next to one invoker pointer. No heap, no manager calls; only trivially copyable
+// callables that fit are accepted.
+
+template <typename Signature, size_t Capacity = 16>
+class InplaceFunction;
+
+template <typename R, size_t Capacity>
+class InplaceFunction<R(), Capacity> {
+public:
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<F, InplaceFunction>>>
+    InplaceFunction(F f) : invoke_([](const void* storage) -> R { return (*static_cast<const F*>(storage))(); }) {
+        static_assert(sizeof(F) <= Capacity && std::is_trivially_copyable_v<F>, "callable does not fit");
+        ::new (static_cast<void*>(storage_)) F(f);
+    }
+
+    R operator()() const { return invoke_(storage_); }
+
+private:
+    R (*invoke_)(const void*);
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+};
+
+template <int N>
+struct Inplace {
+    using Collection = std::vector<InplaceFunction<float()>>;
+
+    static Collection build(const std::vector<Element>& elements) {
+        Collection collection;
+        for (const Element& e : elements) {
+            with_type<N>(e.type, [&](auto k) {
+                collection.emplace_back([shape = Shape<k>{e.a, e.b}] { return shape.eval(); });
+            });
+        }
+        return collection;
+    }
+};
+
+float prfct_sum_inplace_function(const std::vector<InplaceFunction<float()>>& collection) {
+    float sum = 0.0f;
+    for (const auto& function : collection) {
+        sum += function();
+    }
+    return sum;
+}
+
+// ========== FUNCTION REF ==========
+// Non-owning callable reference (object pointer + invoker), objects live elsewhere
+
+class FunctionRef {
+public:
+    template <typename T>
+    explicit FunctionRef(const T& object)
+        : object_(&object), invoke_([](const void* o) { return static_cast<const T*>(o)->eval(); }) {}
+
+    float operator()() const { return invoke_(object_); }
+
+private:
+    const void* object_;
+    float (*invoke_)(const void*);
+};
+
+template <int N>
+struct FunctionRefs {
+    // The referenced shapes are kept in one vector per type (reserved: stable addresses)
+    struct Collection {
+        PerType<Shape, N> shapes;
+        std::vector<FunctionRef> refs;
+    };
+
+    static Collection build(const std::vector<Element>& elements) {
+        Collection collection;
+        std::apply([&](auto&... shapes) { (shapes.reserve(elements.size()), ...); }, collection.shapes);
+        for (const Element& e : elements) {
+            with_type<N>(e.type, [&](auto k) {
+                auto& shapes = std::get<k>(collection.shapes);
+                shapes.push_back(Shape<k>{e.a, e.b});
+                collection.refs.emplace_back(shapes.back());
+            });
+        }
+        return collection;
+    }
+};
+
+template <typename Collection>
+float prfct_sum_function_ref(const Collection& collection) {
+    float sum = 0.0f;
+    for (const FunctionRef& function : collection.refs) {
+        sum += function();
+    }
+    return sum;
+}
+
+// ========== CRTP ==========
+// Static polymorphism: the type of every call is known at compile time, so elements
+// must be stored per type (Partitioned only); each loop inlines its eval()
+
+template <typename Derived>
+struct CrtpBase {
+    float eval() const { return static_cast<const Derived&>(*this).eval_impl(); }
+};
+
+template <int K>
+struct CrtpShape : CrtpBase<CrtpShape<K>> {
+    Shape<K> shape;
+    explicit CrtpShape(Shape<K> s) : shape(s) {}
+    float eval_impl() const { return shape.eval(); }
+};
+
+template <int N>
+struct Crtp {
+    using Collection = PerType<CrtpShape, N>;
+
+    static Collection build(const std::vector<Element>& elements) {
+        Collection collection;
+        for (const Element& e : elements) {
+            with_type<N>(e.type, [&](auto k) { std::get<k>(collection).emplace_back(Shape<k>{e.a, e.b}); });
+        }
+        return collection;
+    }
+};
+
+template <typename T>
+float prfct_sum_crtp_partition(const std::vector<T>& partition) {
+    float sum = 0.0f;
+    for (const auto& object : partition) {
+        sum += object.eval();
+    }
+    return sum;
+}
+
+template <typename Collection>
+float prfct_sum_crtp(const Collection& collection) {
+    return std::apply([](const auto&... partitions) { return (0.0f + ... + prfct_sum_crtp_partition(partitions)); },
+                      collection);
+}
+
+// ========== DISPATCH ==========
+
+float sum(const std::vector<std::unique_ptr<VirtualBase>>& c) { return prfct_sum_virtual(c); }
+float sum(const std::vector<std::function<float()>>& c) { return prfct_sum_std_function(c); }
+float sum(const std::vector<InplaceFunction<float()>>& c) { return prfct_sum_inplace_function(c); }
+template <typename... T>
+float sum(const std::vector<std::variant<T...>>& c) { return prfct_sum_variant(c); }
+template <typename... T>
+float sum(const std::tuple<std::vector<T>...>& c) { return prfct_sum_crtp(c); }
+
+template <template <int> class Strategy, int N>
+float sum_collection(const typename Strategy<N>::Collection& c) {
+    if constexpr (std::is_same_v<Strategy<N>, FunctionPointer<N>>) {
+        return prfct_sum_function_pointer<N>(c);
+    } else if constexpr (std::is_same_v<Strategy<N>, FunctionRefs<N>>) {
+        return prfct_sum_function_ref(c);
+    } else {
+        return sum(c);
+    }
+}
+
+// ========== BENCHMARKS ==========
+// items_per_second: elements (calls) per second
+
+template <template <int> class Strategy, int N, Order O>
+static void BM_Dispatch(benchmark::State& state) {
+    const std::vector<Element> elements = make_elements(N, O);
+
+    // Partitioned: one collection per type (CRTP keeps its per-type vectors in one tuple)
+    std::vector<typename Strategy<N>::Collection> collections;
+    if (O == Order::Partitioned && !std::is_same_v<Strategy<N>, Crtp<N>>) {
+        for (int type = 0; type < N; ++type) {
+            std::vector<Element> partition;
+            std::copy_if(elements.begin(), elements.end(), std::back_inserter(partition),
+                         [type](const Element& e) { return e.type == type; });
+            collections.push_back(Strategy<N>::build(partition));
+        }
+    } else {
+        collections.push_back(Strategy<N>::build(elements));
+    }
+
+    for (auto _ : state) {
+        float result = 0.0f;
+        for (const auto& collection : collections) {
+            result += sum_collection<Strategy, N>(collection);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(COUNT));
+}
+
+// Names: Dispatch/<N>types_<Order>/<Strategy>, grouped per type count and order in summary.md
+#define PERFECTION_DISPATCH_BENCHMARKS(N, O, Label)                                                        \
+    BENCHMARK(BM_Dispatch<Virtual, N, O>)->Name("Dispatch/" #N "types_" Label "/Virtual");               \
+    BENCHMARK(BM_Dispatch<Variant, N, O>)->Name("Dispatch/" #N "types_" Label "/Variant");               \
+    BENCHMARK(BM_Dispatch<FunctionPointer, N, O>)->Name("Dispatch/" #N "types_" Label "/FunctionPointer"); \
+    BENCHMARK(BM_Dispatch<StdFunction, N, O>)->Name("Dispatch/" #N "types_" Label "/StdFunction");       \
+    BENCHMARK(BM_Dispatch<Inplace, N, O>)->Name("Dispatch/" #N "types_" Label "/InplaceFunction");       \
+    BENCHMARK(BM_Dispatch<FunctionRefs, N, O>)->Name("Dispatch/" #N "types_" Label "/FunctionRef")
+
+#define PERFECTION_DISPATCH_TYPES(N)                                                 \
+    PERFECTION_DISPATCH_BENCHMARKS(N, Order::Sorted, "Sorted");                      \
+    PERFECTION_DISPATCH_BENCHMARKS(N, Order::Shuffled, "Shuffled");                  \
+    PERFECTION_DISPATCH_BENCHMARKS(N, Order::Partitioned, "Partitioned");            \
+    BENCHMARK(BM_Dispatch<Crtp, N, Order::Partitioned>)->Name("Dispatch/" #N "types_Partitioned/CRTP")
+
+PERFECTION_DISPATCH_TYPES(2);
+PERFECTION_DISPATCH_TYPES(4);
+PERFECTION_DISPATCH_TYPES(16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define NOINLINE __attribute__((noinline))
+#endif
+
+// =============================================================================
+// Error Propagation Cost Model
+// =============================================================================
+// A batch of CALLS calls, each descending `depth` frames before the innermost one
+// succeeds or fails (a precomputed pattern with the requested failure rate). The
+// failure travels back up through every frame with one of four mechanisms:
+// - Exception: throw std::runtime_error, caught at the top (unwinding)
+// - ReturnCode: bool result, value through an out parameter
+// - Result: std::expected-style Result<int, Error> returned by value
+// - ErrorCode: std::error_code out parameter
+// The chains are NOINLINE so every frame is real, and every frame holds a Cleanup
+// with a non-trivial destructor, so unwinding has a landing pad to run in each frame
+// (as with RAII in real code).
+
+// Calls per batch (benchmark iteration)
+static constexpr size_t CALLS = 1024;
+
+struct Cleanup {
+    int value;
+    ~Cleanup() { benchmark::DoNotOptimize(value); }
+};
+
+// CALLS flags, round(CALLS * permille / 1000) of them set, in random order
+inline std::vector<uint8_t> failure_pattern(int permille, unsigned seed = 42) {
+    std::vector<uint8_t> pattern(CALLS, 0);
+    size_t failures = (CALLS * static_cast<size_t>(permille) + 500) / 1000;
+    std::fill(pattern.begin(), pattern.begin() + static_cast<std::ptrdiff_t>(failures), 1);
+    std::mt19937 gen(seed);
+    std::shuffle(pattern.begin(), pattern.end(), gen);
+    return pattern;
+}
+
+// Failure rate label: 0%, 0.1%, 1%, ..., 50%
+inline std::string rate_label(int permille) {
+    std::string label = std::to_string(permille / 10);
+    if (permille % 10 != 0) {
+        label += "." + std::to_string(permille % 10);
+    }
+    return label + "%";
+}
+
+// ========== EXCEPTION ==========
+
+inline NOINLINE int prfct_chain_exception(int depth, bool fail, int value) {
+    Cleanup cleanup{value};
+    if (depth == 1) {
+        if (fail) {
+            throw std::runtime_error("failure");
+        }
+        return value + 1;
+    }
+    return prfct_chain_exception(depth - 1, fail, value + 1) + 1;
+}
+
+// ========== RETURN CODE ==========
+
+inline NOINLINE bool prfct_chain_return_code(int depth, bool fail, int value, int& out) {
+    Cleanup cleanup{value};
+    if (depth == 1) {
+        if (fail) {
+            return false;
+        }
+        out = value + 1;
+        return true;
+    }
+    if (!prfct_chain_return_code(depth - 1, fail, value + 1, out)) {
+        return false;
+    }
+    out += 1;
+    return true;
+}
+
+// ========== RESULT TYPE ==========
+// Minimal std::expected (C++23) stand-in: value or error plus a flag, returned in registers
+// or through the return slot
+
+struct Error {
+    int code;
+};
+
+template <typename T, typename E>
+class Result {
+public:
+    static Result success(T value) { return Result(true, value, E{}); }
+    static Result failure(E error) { return Result(false, T{}, error); }
+
+    bool has_value() const { return has_value_; }
+    const T& value() const { return value_; }
+    const E& error() const { return error_; }
+
+private:
+    Result(bool has_value, T value, E error) : has_value_(has_value), value_(value), error_(error) {}
+
+    bool has_value_;
+    T value_;
+    E error_;
+};
+
+inline NOINLINE Result<int, Error> prfct_chain_result(int depth, bool fail, int value) {
+    Cleanup cleanup{value};
+    if (depth == 1) {
+        if (fail) {
+            return Result<int, Error>::failure(Error{1});
+        }
+        return Result<int, Error>::success(value + 1);
+    }
+    Result<int, Error> inner = prfct_chain_result(depth - 1, fail, value + 1);
+    if (!inner.has_value()) {
+        return inner;
+    }
+    return Result<int, Error>::success(inner.value() + 1);
+}
+
+// ========== ERROR CODE ==========
+
+inline NOINLINE int prfct_chain_error_code(int depth, bool fail, int value, std::error_code& ec) {
+    Cleanup cleanup{value};
+    if (depth == 1) {
+        if (fail) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return 0;
+        }
+        return value + 1;
+    }
+    int inner = prfct_chain_error_code(depth - 1, fail, value + 1, ec);
+    if (ec) {
+        return 0;
+    }
+    return inner + 1;
+}
+
+// ========== BATCHES ==========
+// Run CALLS chains and return the number of failures
+
+inline size_t run_exception(const std::vector<uint8_t>& pattern, int depth) {
+    size_t failures = 0;
+    int sum = 0;
+    for (size_t i = 0; i < CALLS; ++i) {
+        try {
+            sum += prfct_chain_exception(depth, pattern[i] != 0, static_cast<int>(i));
+        } catch (const std::runtime_error&) {
+            failures++;
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    return failures;
+}
+
+inline size_t run_return_code(const std::vector<uint8_t>& pattern, int depth) {
+    size_t failures = 0;
+    int sum = 0;
+    for (size_t i = 0; i < CALLS; ++i) {
+        int out = 0;
+        if (prfct_chain_return_code(depth, pattern[i] != 0, static_cast<int>(i), out)) {
+            sum += out;
+        } else {
+            failures++;
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    return failures;
+}
+
+inline size_t run_result(const std::vector<uint8_t>& pattern, int depth) {
+    size_t failures = 0;
+    int sum = 0;
+    for (size_t i = 0; i < CALLS; ++i) {
+        Result<int, Error> result = prfct_chain_result(depth, pattern[i] != 0, static_cast<int>(i));
+        if (result.has_value()) {
+            sum += result.value();
+        } else {
+            failures++;
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    return failures;
+}
+
+inline size_t run_error_code(const std::vector<uint8_t>& pattern, int depth) {
+    size_t failures = 0;
+    int sum = 0;
+    for (size_t i = 0; i < CALLS; ++i) {
+        std::error_code ec;
+        int out = prfct_chain_error_code(depth, pattern[i] != 0, static_cast<int>(i), ec);
+        if (ec) {
+            failures++;
+        } else {
+            sum += out;
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    return failures;
+}
+
+using Batch = size_t (*)(const std::vector<uint8_t>&, int);
+
+// items_per_second: calls per second; 'failures' counts the failed calls per batch
+// (averaged over the threads of threaded runs, whose user counters are otherwise summed)
+inline void BM_failure(benchmark::State& state, Batch batch, int permille, int depth) {
+    const std::vector<uint8_t> pattern = failure_pattern(permille, 42 + static_cast<unsigned>(state.thread_index()));
+    size_t failures = 0;
+
+    for (auto _ : state) {
+        failures = batch(pattern, depth);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(CALLS));
+    state.counters["failures"] = benchmark::Counter(static_cast<double>(failures), benchmark::Counter::kAvgThreads);
+}
@@ -2,6 +2,8 @@
 #include <stdexcept>
 #include <benchmark/benchmark.h>
 
+#include "common.h"
+
 static char random_data[1024*1024];
 
 void initialize_random_data() {
@@ -113,4 +115,25 @@ BENCHMARK(BM_process_return_code);
 BENCHMARK(BM_process_exception);
 BENCHMARK(BM_process_try_no_throw);
 
+// ========== FAILURE RATE x DEPTH SWEEP ==========
+// Names: Failure/<rate>_depth<frames>/<Mechanism>, one summary table per rate and depth
+
+static constexpr int FAILURE_PERMILLE[] = {0, 1, 10, 50, 100, 250, 500};
+static constexpr int DEPTHS[] = {1, 4, 16, 64};
+
+static bool register_failure_sweep() {
+    for (int permille : FAILURE_PERMILLE) {
+        for (int depth : DEPTHS) {
+            std::string group = "Failure/" + rate_label(permille) + "_depth" + std::to_string(depth) + "/";
+            benchmark::RegisterBenchmark((group + "Exception").c_str(), BM_failure, run_exception, permille, depth);
+            benchmark::RegisterBenchmark((group + "ReturnCode").c_str(), BM_failure, run_return_code, permille, depth);
+            benchmark::RegisterBenchmark((group + "Result").c_str(), BM_failure, run_result, permille, depth);
+            benchmark::RegisterBenchmark((group + "ErrorCode").c_str(), BM_failure, run_error_code, permille, depth);
+        }
+    }
+    return true;
+}
+
+static const bool registered = register_failure_sweep();
+
 BENCHMARK_MAIN();
@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include "common.h"
+
+// Thread sweep: max_threads()
+#include "../common/threads.h"
+
+// Multithreaded unwinding: every thread runs the same batches concurrently. Throwing
+// walks the unwind tables of the loaded objects; with older libgcc/glibc combinations
+// the unwinder serializes threads on a global lock (dl_iterate_phdr), newer ones
+// (GCC 13+ with glibc 2.35+ _dl_find_object) look up frames without it. Return-path
+// mechanisms share nothing between threads and are the scaling baseline.
+
+// Unwind depth of the threaded runs
+static constexpr int DEPTH = 16;
+
+static constexpr int FAILURE_PERMILLE[] = {10, 100, 500};
+
+// Names: Threads/<rate>_depth16/<Mechanism>/real_time/threads:<N>
+static bool register_threaded() {
+    for (int permille : FAILURE_PERMILLE) {
+        std::string group = "Threads/" + rate_label(permille) + "_depth" + std::to_string(DEPTH) + "/";
+        benchmark::RegisterBenchmark((group + "Exception").c_str(), BM_failure, run_exception, permille, DEPTH)
+            ->ThreadRange(1, max_threads())
+            ->UseRealTime();
+        benchmark::RegisterBenchmark((group + "ReturnCode").c_str(), BM_failure, run_return_code, permille, DEPTH)
+            ->ThreadRange(1, max_threads())
+            ->UseRealTime();
+        benchmark::RegisterBenchmark((group + "Result").c_str(), BM_failure, run_result, permille, DEPTH)
+            ->ThreadRange(1, max_threads())
+            ->UseRealTime();
+    }
+    return true;
+}
+
+static const bool registered = register_threaded();
+
+BENCHMARK_MAIN();
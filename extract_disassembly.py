@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""
+Extract the functions under study (prfct_ prefix) from a benchmark binary.
+
+Reads the symbol table (nm) to find the functions and their sizes, disassembles only
+the address range they span in one objdump pass, and prints each function followed by
+a per-function report: code size, instruction count and loops (backward jumps).
+
+Output format (appended to .disassembly/<project>/<config>.dis by disassembly.sh):
+    Functions:
+    | Function          | Size  | Instructions | Loops |
+    ...
+    ========== prfct_foo() ==========
+    00000000000013b0 <prfct_foo()>:
+    	0f b6 0a             	movzbl (%rdx),%ecx
+    ...
+    Loops: 0x13c8-0x13e0 (8 instructions)
+    Size: 51 B, 13 instructions
+
+Usage:
+    python3 extract_disassembly.py <binary> [pattern]
+"""
+
+import re
+import subprocess
+import sys
+from typing import Dict, List, Optional, Tuple
+
+
+DEFAULT_PATTERN = "prfct_"
+
+# objdump -d -C function header: '00000000000013b0 <prfct_foo()>:'
+HEADER_RE = re.compile(r'^([0-9a-f]+) <(.*)>:$')
+
+# objdump -d instruction line: '    13b0:\t48 8d 15 09 2d 00 00 \tlea    0x2d09(%rip),%rdx'
+# Long encodings continue on a line with bytes only (no mnemonic)
+INSTRUCTION_RE = re.compile(r'^\s*([0-9a-f]+):\t([0-9a-f ]+?)\s*(?:\t(.*))?$')
+
+# Direct jump target: 'jne    13c8 <prfct_foo()+0x18>'
+JUMP_TARGET_RE = re.compile(r'^([0-9a-f]+)\b')
+
+
+def read_symbols(binary: str, pattern: str) -> Dict[int, Tuple[str, int]]:
+    """
+    Read the matching function symbols from the symbol table.
+    
+    Returns: {address: (demangled name, size in bytes)}
+    """
+    output = subprocess.run(['nm', '-C', '-S', '--defined-only', binary],
+                            capture_output=True, text=True, check=True).stdout
+    symbols = {}
+    for line in output.splitlines():
+        # '00000000000013b0 0000000000000033 T prfct_foo()'
+        parts = line.split(' ', 3)
+        if len(parts) != 4 or parts[2] not in ('T', 't', 'W', 'w') or pattern not in parts[3]:
+            continue
+        symbols[int(parts[0], 16)] = (parts[3], int(parts[1], 16))
+    return symbols
+
+
+def disassemble(binary: str, start: int, stop: int) -> List[str]:
+    """One objdump pass over [start, stop)."""
+    return subprocess.run(['objdump', '-d', '-C', f'--start-address={start:#x}', f'--stop-address={stop:#x}', binary],
+                          capture_output=True, text=True, check=True).stdout.splitlines()
+
+
+def split_functions(lines: List[str], symbols: Dict[int, Tuple[str, int]]) -> List[Dict]:
+    """
+    Split an objdump listing into the functions listed in symbols.
+    
+    Returns: [{'name', 'address', 'size', 'lines': [raw lines], 'instructions': [(address, mnemonic, operands)]}]
+    Instructions past the symbol size (alignment padding) are kept in 'lines' but not counted.
+    """
+    functions = []
+    current: Optional[Dict] = None
+    for line in lines:
+        header = HEADER_RE.match(line)
+        if header:
+            address = int(header.group(1), 16)
+            current = None
+            if address in symbols:
+                name, size = symbols[address]
+                current = {'name': name, 'address': address, 'size': size, 'lines': [line], 'instructions': []}
+                functions.append(current)
+            continue
+        if current is None or not line.strip():
+            continue
+        
+        current['lines'].append(line)
+        instruction = INSTRUCTION_RE.match(line)
+        if not instruction or not instruction.group(3):
+            continue
+        address = int(instruction.group(1), 16)
+        if current['size'] and address >= current['address'] + current['size']:
+            continue
+        mnemonic, _, operands = instruction.group(3).partition(' ')
+        current['instructions'].append((address, mnemonic, operands.strip()))
+    
+    for function in functions:
+        # Symbols without size information: up to the last instruction
+        if not function['size'] and function['instructions']:
+            function['size'] = function['instructions'][-1][0] - function['address']
+    return functions
+
+
+def find_loops(function: Dict) -> List[Tuple[int, int, int]]:
+    """
+    Find loops as backward jumps inside the function.
+    
+    Returns: [(body start, jump address, instructions in the body)] ordered by start address
+    """
+    instructions = function['instructions']
+    start, end = function['address'], function['address'] + function['size']
+    loops = []
+    for address, mnemonic, operands in instructions:
+        if not (mnemonic.startswith('j') or mnemonic.startswith('loop')):
+            continue
+        target = JUMP_TARGET_RE.match(operands)
+        if not target:
+            continue  # indirect jump
+        target_address = int(target.group(1), 16)
+        if start <= target_address <= address < end:
+            body = sum(1 for a, _, _ in instructions if target_address <= a <= address)
+            loops.append((target_address, address, body))
+    return sorted(loops)
+
+
+def format_summary(functions: List[Dict]) -> str:
+    """Markdown table: one row per function with size, instruction count and loop count."""
+    header = ['Function', 'Size', 'Instructions', 'Loops']
+    rows = [[f['name'], f"{f['size']} B", str(len(f['instructions'])), str(len(find_loops(f)))]
+            for f in functions]
+    widths = [max(len(header[i]), *(len(row[i]) for row in rows)) for i in range(len(header))]
+    
+    lines = ["| " + " | ".join(h.ljust(w) for h, w in zip(header, widths)) + " |"]
+    lines.append("|" + "|".join("-" * (w + 2) for w in widths) + "|")
+    for row in rows:
+        cells = [row[0].ljust(widths[0])] + [cell.rjust(w) for cell, w in zip(row[1:], widths[1:])]
+        lines.append("| " + " | ".join(cells) + " |")
+    return "Functions:\n" + "\n".join(lines) + "\n"
+
+
+def format_function(function: Dict) -> str:
+    """One function: header, listing without address columns, loop report."""
+    md = f"========== {function['name']} ==========\n"
+    for line in function['lines']:
+        instruction = INSTRUCTION_RE.match(line)
+        # Drop the address column so listings diff cleanly between configurations
+        md += (line[line.index(':') + 1:] if instruction else line) + "\n"
+    md += "\n"
+    
+    loops = find_loops(function)
+    if loops:
+        md += "Loops: " + ", ".join(f"{start:#x}-{end:#x} ({body} instructions)" for start, end, body in loops) + "\n"
+    md += f"Size: {function['size']} B, {len(function['instructions'])} instructions\n\n"
+    return md
+
+
+def extract_functions(binary: str, pattern: str = DEFAULT_PATTERN) -> List[Dict]:
+    """Every matching function of the binary (see split_functions), sorted by name."""
+    symbols = read_symbols(binary, pattern)
+    if not symbols:
+        return []
+    
+    start = min(symbols)
+    stop = max(address + max(size, 1) for address, (_, size) in symbols.items())
+    functions = split_functions(disassemble(binary, start, stop), symbols)
+    return sorted(functions, key=lambda f: f['name'])
+
+
+def extract(binary: str, pattern: str = DEFAULT_PATTERN) -> str:
+    """Summary table plus every matching function of the binary."""
+    functions = extract_functions(binary, pattern)
+    if not functions:
+        return ""
+    return format_summary(functions) + "\n" + "".join(format_function(f) for f in functions)
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        print(f"Usage: {sys.argv[0]} <binary> [pattern]")
+        print(f"Example: {sys.argv[0]} .build/inlining/clang_O3/inlining")
+        sys.exit(1)
+    
+    pattern = sys.argv[2] if len(sys.argv) == 3 else DEFAULT_PATTERN
+    try:
+        sys.stdout.write(extract(sys.argv[1], pattern))
+    except subprocess.CalledProcessError as e:
+        print(f"Error: {' '.join(e.cmd)} failed: {e.stderr.strip()}", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -14,6 +14,10 @@ fi
 echo "Generating summaries for all projects..."
 echo ""
 
+# Rebuild the merged results store from all per-run JSON files
+python3 "${SCRIPT_DIR}/perfection_results.py" merge "${BENCHMARKS_DIR}"
+echo ""
+
 generated_count=0
 skipped_count=0
 
@@ -24,17 +28,16 @@ for project_dir in "${BENCHMARKS_DIR}"/*/ ; do
     fi
     
     project_name=$(basename "${project_dir}")
-    benchmark_log="${project_dir}/benchmark.log"
     
-    if [ ! -f "${benchmark_log}" ]; then
-        echo "⊘ Skipped ${project_name}: no benchmark.log"
+    if [ ! -d "${project_dir}/runs" ]; then
+        echo "⊘ Skipped ${project_name}: no JSON runs (re-run benchmarks.sh)"
         skipped_count=$((skipped_count + 1))
         continue
     fi
     
     echo "→ Processing ${project_name}..."
     
-    if python3 "${SCRIPT_DIR}/generate_summary.py" "${benchmark_log}"; then
+    if python3 "${SCRIPT_DIR}/generate_summary.py" "${project_dir}"; then
         generated_count=$((generated_count + 1))
     else
         echo "  ✗ Failed to generate summary for ${project_name}"
@@ -1,56 +1,283 @@
 #!/usr/bin/env python3
 """
-Generate summary.md from benchmark.log.
+Generate summary.md for a project from the merged results store.
 
-Extracts O3 results and creates comparison tables.
+Reads .benchmarks/results.json (see perfection_results.py) and creates comparison tables.
 Supports both simple (BM_name) and hierarchical (Operation/Size/Container) naming.
+Hardware counters (benchmarks.sh with PERFECTION_COUNTERS) get their own tables.
+Repeated runs (PERFECTION_REPETITIONS) show the median with its 95% confidence interval.
+Profile-guided builds (pgo.sh) are compared against the plain -O3 build.
 """
 
 import re
 import sys
 from pathlib import Path
 from collections import defaultdict
-from typing import Dict, List, Tuple
+from typing import Callable, Dict, List, Optional, Tuple
 
+from perfection_results import STORE_NAME, load_store, measured_time_ns, median, summarize
 
-def parse_benchmark_log(log_path: Path) -> Dict[str, Dict[str, str]]:
+
+# Preferred column order for hardware counters; others follow alphabetically
+COUNTER_ORDER = ['CYCLES', 'INSTRUCTIONS', 'IPC', 'BRANCH-MISSES', 'CACHE-MISSES']
+
+# Flag profiles of the profile-guided builds of pgo.sh, compared against the plain build
+PGO_PROFILES = ('pgo', 'autofdo')
+
+
+def config_label(record: Dict) -> str:
+    """Column label of a record's configuration: 'clang-O3', with flag profile 'clang-O3_v3_lto'."""
+    label = f"{record['compiler']}-{record['opt_level']}"
+    if record.get('profile'):
+        label += f"_{record['profile']}"
+    return label
+
+
+def order_configs(configs) -> List[str]:
+    """
+    Order configuration columns: highest optimization first, plain before flag profiles,
+    clang before gcc.
+    
+    Input: ['gcc-O0', 'gcc-O3_lto', 'clang-O3', 'gcc-O3']
+    Output: ['clang-O3', 'gcc-O3', 'gcc-O3_lto', 'gcc-O0']
+    """
+    opt_rank = {'O3': 0, 'Ofast': 1, 'O2': 2, 'Os': 3, 'O1': 4, 'O0': 5}
+
+    def key(config: str):
+        compiler, _, opt_level = config.partition('-')
+        opt, _, profile = opt_level.partition('_')
+        return (opt_rank.get(opt, len(opt_rank)), opt, profile, compiler)
+    
+    return sorted(configs, key=key)
+
+
+def order_config_names(configs) -> List[str]:
+    """
+    Order configuration names (as in results.json and .build/) like the summary columns.
+    
+    Input: ['gcc_O0', 'gcc_O3_lto', 'clang_O3', 'gcc_O3']
+    Output: ['clang_O3', 'gcc_O3', 'gcc_O3_lto', 'gcc_O0']
+    """
+    labels = {config.replace('_', '-', 1): config for config in configs}
+    return [labels[label] for label in order_configs(labels)]
+
+
+def project_report_main(project: str, output_name: str, generate: Callable[[List[Dict]], str]):
+    """
+    Command line of the per-project report scripts: <script> [results.json]
+    
+    Writes generate(records of the project) to <store dir>/<project>/<output_name> and prints it.
+    """
+    if len(sys.argv) > 2:
+        print(f"Usage: {sys.argv[0]} [results.json]")
+        sys.exit(1)
+    
+    store_path = Path(sys.argv[1]) if len(sys.argv) == 2 else Path(__file__).resolve().parent / '.benchmarks' / STORE_NAME
+    if not store_path.exists():
+        print(f"Error: File not found: {store_path} (run: ./benchmarks.sh {project})")
+        sys.exit(1)
+    
+    report = generate(load_store(store_path, project))
+    
+    output_path = store_path.parent / project / output_name
+    output_path.parent.mkdir(parents=True, exist_ok=True)
+    with open(output_path, 'w') as f:
+        f.write(report)
+    
+    print(report)
+    print(f"✓ Generated: {output_path}")
+
+
+def natural_key(name: str) -> List:
+    """
+    Sort key comparing digit runs numerically.
+    
+    Input: ['BM_seq/65536', 'BM_seq/4096']
+    Output (sorted): ['BM_seq/4096', 'BM_seq/65536']
+    """
+    return [int(part) if part.isdigit() else part for part in re.split(r'(\d+)', name)]
+
+
+def format_time(ns: float) -> str:
+    """Format a time in ns like Google Benchmark's console: '0.99 ns', '16.5 ns', '1234 ns'."""
+    if ns < 10:
+        return f"{ns:.2f} ns"
+    if ns < 100:
+        return f"{ns:.1f} ns"
+    return f"{ns:.0f} ns"
+
+
+def load_results(records: List[Dict]) -> Tuple[Dict[str, Dict[str, str]],
+                                              Dict[str, Dict[str, Dict[str, float]]],
+                                              Dict[str, Dict[str, Dict]]]:
     """
-    Parse benchmark.log and extract results.
+    Build per-configuration results from store records.
+    
+    Times are in ns whatever unit the benchmark reported in (CPU time; wall time for
+    UseRealTime() and multithreaded benchmarks, see measured_time_ns). Repeated measurements
+    are reduced to their median (outliers rejected); counters to their per-counter median.
+    IPC is derived from CYCLES and INSTRUCTIONS counters.
     
     Returns:
-        {
-            'clang-O3': {'BM_test1': '123 ns', ...},
-            'clang-O2': {'BM_test1': '125 ns', ...},
-            'gcc-O3': {'BM_test1': '120 ns', ...},
-            ...
-        }
+        (
+            {'clang-O3': {'BM_test1': '123 ns', ...}, ...},                  # time (measured_time_ns)
+            {'clang-O3': {'BM_test1': {'CYCLES': 1.2e6, 'IPC': 2.58}}, ...},  # counters
+            {'clang-O3': {'BM_test1': {'n': 10, 'median': 123.4, ...}}, ...}, # statistics
+        )
     """
+    samples = defaultdict(lambda: defaultdict(list))
+    counter_samples = defaultdict(lambda: defaultdict(lambda: defaultdict(list)))
+    
+    for record in records:
+        config = config_label(record)
+        bench_name = record['benchmark']
+        samples[config][bench_name].append(measured_time_ns(record))
+        for name, value in record.get('counters', {}).items():
+            counter_samples[config][bench_name][name].append(value)
+    
     results = defaultdict(dict)
-    current_config = None
-    
-    with open(log_path, 'r') as f:
-        for line in f:
-            # Detect configuration header: "========== clang -O3 =========="
-            config_match = re.match(r'=+\s+(clang|gcc)\s+-O(\d)', line)
-            if config_match:
-                compiler = config_match.group(1)
-                opt_level = config_match.group(2)
-                current_config = f"{compiler}-O{opt_level}"
-                continue
-            
-            # Process all optimization levels
-            if current_config:
-                # Match benchmark result line
-                # Format: "BM_name     123 ns     123 ns    12345"
-                # or: "Operation/Size/Container     123 ns     123 ns    12345"
-                bench_match = re.match(r'(\S+)\s+[\d.]+\s+ns\s+([\d.]+)\s+ns', line)
-                if bench_match:
-                    bench_name = bench_match.group(1)
-                    cpu_time_str = bench_match.group(2)
-                    # Store with " ns" suffix for consistency
-                    results[current_config][bench_name] = f"{cpu_time_str} ns"
-    
-    return dict(results)
+    stats = defaultdict(dict)
+    for config, benchmarks in samples.items():
+        for bench_name, values in benchmarks.items():
+            stats[config][bench_name] = summarize(values)
+            results[config][bench_name] = format_time(stats[config][bench_name]['median'])
+    
+    counters = defaultdict(dict)
+    for config, benchmarks in counter_samples.items():
+        for bench_name, named_values in benchmarks.items():
+            values = {name: median(v) for name, v in named_values.items()}
+            if values.get('CYCLES') and 'INSTRUCTIONS' in values:
+                values['IPC'] = values['INSTRUCTIONS'] / values['CYCLES']
+            counters[config][bench_name] = values
+    
+    return dict(results), dict(counters), dict(stats)
+
+
+def significance_annotations(configs: List[str], rows: List[str],
+                             stats: Dict[str, Dict[str, Dict]]) -> Dict[str, Dict[str, str]]:
+    """
+    Annotate each cell with its confidence interval and significance against the column's best.
+    
+    ' ±2.1%*' - fastest entry in the column
+    ' ±1.8%~' - interval overlaps the fastest one: difference is not significant
+    ' ±3.0%'  - significantly slower than the fastest entry
+    """
+    annotations = defaultdict(dict)
+    for config in configs:
+        column = {row: stats[config][row] for row in rows if row in stats.get(config, {})}
+        if not column:
+            continue
+        best = min(column, key=lambda row: column[row]['median'])
+        for row, stat in column.items():
+            half_width = (stat['ci_high'] - stat['ci_low']) / 2
+            percent = 100 * half_width / stat['median'] if stat['median'] else 0
+            if row == best:
+                marker = '*'
+            elif stat['ci_low'] <= column[best]['ci_high']:
+                marker = '~'
+            else:
+                marker = ''
+            annotations[config][row] = f" ±{percent:.1f}%{marker}"
+    return dict(annotations)
+
+
+def has_repetitions(stats: Dict[str, Dict[str, Dict]]) -> bool:
+    """True if any benchmark was measured more than once."""
+    return any(stat['n'] > 1 for benchmarks in stats.values() for stat in benchmarks.values())
+
+
+def generate_outlier_list(stats: Dict[str, Dict[str, Dict]]) -> str:
+    """List the benchmarks whose repetitions contained rejected outliers."""
+    md = ""
+    for config in order_configs(stats.keys()):
+        for bench_name, stat in sorted(stats[config].items()):
+            if stat['outliers']:
+                rejected = ', '.join(format_time(v) for v in stat['outliers'])
+                md += f"- {config} {bench_name}: {len(stat['outliers'])} of {stat['n']} rejected ({rejected})\n"
+    if not md:
+        return ""
+    return "## Rejected Outliers\n\n" + md + "\n"
+
+
+def generate_pgo_comparison(stats: Dict[str, Dict[str, Dict]]) -> str:
+    """
+    Compare profile-guided builds (pgo.sh: 'gcc-O3_pgo', 'gcc-O3_autofdo') against the
+    same compiler's plain build ('gcc-O3'). Negative change: the profile made it faster.
+    
+    Output:
+        | Benchmark      | Baseline | Build      |      Base |       PGO | Change |
+        | BM_predictable | gcc-O3   | gcc-O3_pgo | 812345 ns | 701234 ns | -13.7% |
+    """
+    rows = []
+    for config in order_configs(stats.keys()):
+        compiler, _, opt_level = config.partition('-')
+        opt, _, profile = opt_level.partition('_')
+        baseline = f"{compiler}-{opt}"
+        if profile not in PGO_PROFILES or baseline not in stats:
+            continue
+        for bench_name in sorted(stats[config].keys() & stats[baseline].keys(), key=natural_key):
+            base = stats[baseline][bench_name]['median']
+            optimized = stats[config][bench_name]['median']
+            change = 100 * (optimized - base) / base if base else 0.0
+            rows.append([bench_name, baseline, config, format_time(base), format_time(optimized), f"{change:+.1f}%"])
+    if not rows:
+        return ""
+    
+    header = ['Benchmark', 'Baseline', 'Build', 'Base', 'PGO', 'Change']
+    widths = [max(len(header[i]), *(len(row[i]) for row in rows)) for i in range(len(header))]
+    lines = ["| " + " | ".join(h.ljust(w) for h, w in zip(header, widths)) + " |"]
+    lines.append("|" + "|".join("-" * (w + 2) for w in widths) + "|")
+    for row in rows:
+        cells = [cell.ljust(w) if i < 3 else cell.rjust(w) for i, (cell, w) in enumerate(zip(row, widths))]
+        lines.append("| " + " | ".join(cells) + " |")
+    return "## Profile-Guided Optimization\n\n" + "\n".join(lines) + "\n"
+
+
+def format_counter(name: str, value: float) -> str:
+    """Format a counter value with an SI suffix ('1.23M'); IPC is shown as a plain ratio."""
+    if name == 'IPC':
+        return f"{value:.2f}"
+    for suffix, scale in (('G', 1e9), ('M', 1e6), ('k', 1e3)):
+        if abs(value) >= scale:
+            return f"{value / scale:.3g}{suffix}"
+    return f"{value:.3g}"
+
+
+def generate_counter_tables(results: Dict[str, Dict[str, str]],
+                            counters: Dict[str, Dict[str, Dict[str, float]]]) -> str:
+    """Generate one markdown table per configuration: measured time next to hardware counters."""
+    md = ""
+    for config in order_configs(counters.keys()):
+        config_counters = counters[config]
+        benchmarks = sorted(config_counters.keys(), key=natural_key)
+        
+        names = set()
+        for values in config_counters.values():
+            names.update(values.keys())
+        columns = [c for c in COUNTER_ORDER if c in names] + sorted(names - set(COUNTER_ORDER))
+        
+        header = ['Benchmark', 'Time'] + columns
+        rows = []
+        for bench in benchmarks:
+            values = config_counters[bench]
+            row = [bench, results.get(config, {}).get(bench, 'N/A')]
+            row += [format_counter(c, values[c]) if c in values else 'N/A' for c in columns]
+            rows.append(row)
+        
+        widths = [max(len(header[i]), max(len(r[i]) for r in rows)) for i in range(len(header))]
+
+        def format_row(cells):
+            return "| " + " | ".join(
+                f"{v:<{w}}" if i == 0 else f"{v:>{w}}" for i, (v, w) in enumerate(zip(cells, widths))) + " |\n"
+        
+        md += f"## Hardware Counters: {config}\n\n"
+        md += format_row(header)
+        md += "|" + "|".join('-' * (w + 2) for w in widths) + "|\n"
+        for row in rows:
+            md += format_row(row)
+        md += "\n"
+    
+    return md
 
 
 def normalize_precision(values: List[str]) -> List[str]:
@@ -78,7 +305,7 @@ def normalize_precision(values: List[str]) -> List[str]:
         if val == "N/A":
             normalized.append(val)
             continue
-            
+        
         num_str = val.replace(" ns", "").strip()
         
         if '.' in num_str:
@@ -113,10 +340,21 @@ def group_hierarchical_benchmarks(benchmarks: Dict[str, str]) -> Dict[str, Dict[
     
     Input: {'Copy/Small_int/StdVector': '15 ns', 'Copy/Small_int/SmallVector': '3 ns'}
     Output: {'Copy/Small_int': {'StdVector': '15 ns', 'SmallVector': '3 ns'}}
+    
+    Range-sized names (Operation/Element/Container/N) are grouped per size, so every
+    table compares the containers at one N:
+    Input: {'Insert/int/StdVector/64': '202 ns', 'Insert/int/SmallVector/64': '112 ns'}
+    Output: {'Insert/int/64': {'StdVector': '202 ns', 'SmallVector': '112 ns'}}
     """
     groups = defaultdict(dict)
     
     for bench_name, time in benchmarks.items():
+        parts = bench_name.split('/')
+        if len(parts) >= 4 and parts[-1].isdigit() and not parts[-2].isdigit():
+            group_name = '/'.join(parts[:-2] + [parts[-1]])
+            groups[group_name][parts[-2]] = time
+            continue
+        
         parts = bench_name.rsplit('/', 1)
         if len(parts) == 2:
             group_name, container = parts
@@ -128,37 +366,37 @@ def group_hierarchical_benchmarks(benchmarks: Dict[str, str]) -> Dict[str, Dict[
     return dict(groups)
 
 
-def generate_simple_table(results: Dict[str, Dict[str, str]]) -> str:
-    """Generate markdown table for simple benchmark names."""
-    # Get all unique benchmark names
-    all_benchmarks = set()
-    for config_results in results.values():
-        all_benchmarks.update(config_results.keys())
-    
-    if not all_benchmarks:
-        return "No benchmarks found.\n"
-    
-    all_benchmarks = sorted(all_benchmarks)
+def generate_table(row_header: str, rows: List[str], configs: List[str],
+                   data: Dict[str, Dict[str, str]],
+                   stats: Optional[Dict[str, Dict[str, Dict]]] = None) -> str:
+    """
+    Generate one markdown table: a row per entry, a column per configuration.
     
+    data: {config: {row: value}}
+    stats: {config: {row: summarize() result}} - adds confidence intervals and significance
+    """
     # Calculate column widths
-    max_bench_width = max(len(bench) for bench in all_benchmarks)
-    max_bench_width = max(max_bench_width, len("Benchmark"))
-    
-    # Define optimization levels in order (highest to lowest)
-    opt_levels = ['O3', 'O2', 'O1', 'O0']
-    compilers = ['clang', 'gcc']  # clang first for each level
+    max_row_width = max(len(row) for row in rows)
+    max_row_width = max(max_row_width, len(row_header))
     
     # Collect values for each config
     all_columns = {}
-    for opt in opt_levels:
-        for compiler in compilers:
-            config = f"{compiler}-{opt}"
-            column_values = []
-            for bench in all_benchmarks:
-                value = results.get(config, {}).get(bench, None)
-                column_values.append(value if value else "N/A")
-            # Normalize precision
-            all_columns[config] = normalize_precision(column_values)
+    for config in configs:
+        column_values = []
+        for row in rows:
+            value = data.get(config, {}).get(row, None)
+            column_values.append(value if value else "N/A")
+        # Normalize precision
+        all_columns[config] = normalize_precision(column_values)
+    
+    # Append confidence intervals after normalization so decimal points stay aligned
+    if stats is not None and has_repetitions(stats):
+        annotations = significance_annotations(configs, rows, stats)
+        for config in configs:
+            all_columns[config] = [
+                value + annotations.get(config, {}).get(row, '')
+                for row, value in zip(rows, all_columns[config])
+            ]
     
     # Calculate max width for each column
     column_widths = {}
@@ -168,52 +406,59 @@ def generate_simple_table(results: Dict[str, Dict[str, str]]) -> str:
         column_widths[config] = max_width
     
     # Build header
-    md = f"| {'Benchmark':<{max_bench_width}} "
-    for opt in opt_levels:
-        for compiler in compilers:
-            config = f"{compiler}-{opt}"
-            md += f"| {config:>{column_widths[config]}} "
+    md = f"| {row_header:<{max_row_width}} "
+    for config in configs:
+        md += f"| {config:>{column_widths[config]}} "
     md += "|\n"
     
     # Build separator
-    md += f"|{'-' * (max_bench_width + 2)}"
-    for opt in opt_levels:
-        for compiler in compilers:
-            config = f"{compiler}-{opt}"
-            md += f"|{'-' * (column_widths[config] + 2)}"
+    md += f"|{'-' * (max_row_width + 2)}"
+    for config in configs:
+        md += f"|{'-' * (column_widths[config] + 2)}"
     md += "|\n"
     
     # Build data rows
-    for i, bench in enumerate(all_benchmarks):
-        md += f"| {bench:<{max_bench_width}} "
-        for opt in opt_levels:
-            for compiler in compilers:
-                config = f"{compiler}-{opt}"
-                value = all_columns[config][i]
-                md += f"| {value:>{column_widths[config]}} "
+    for i, row in enumerate(rows):
+        md += f"| {row:<{max_row_width}} "
+        for config in configs:
+            value = all_columns[config][i]
+            md += f"| {value:>{column_widths[config]}} "
         md += "|\n"
     
     return md
 
 
-def generate_hierarchical_tables(results: Dict[str, Dict[str, str]]) -> str:
+def generate_simple_table(results: Dict[str, Dict[str, str]],
+                          stats: Optional[Dict[str, Dict[str, Dict]]] = None) -> str:
+    """Generate markdown table for simple benchmark names."""
+    # Get all unique benchmark names
+    all_benchmarks = set()
+    for config_results in results.values():
+        all_benchmarks.update(config_results.keys())
+    
+    if not all_benchmarks:
+        return "No benchmarks found.\n"
+    
+    return generate_table("Benchmark", sorted(all_benchmarks, key=natural_key), order_configs(results.keys()), results, stats)
+
+
+def generate_hierarchical_tables(results: Dict[str, Dict[str, str]],
+                                 stats: Optional[Dict[str, Dict[str, Dict]]] = None) -> str:
     """Generate markdown tables for hierarchical benchmark names."""
-    # Define optimization levels in order (highest to lowest)
-    opt_levels = ['O3', 'O2', 'O1', 'O0']
-    compilers = ['clang', 'gcc']  # clang first for each level
+    configs = order_configs(results.keys())
     
     # Group benchmarks for all configs
     all_groups_data = {}
-    for opt in opt_levels:
-        for compiler in compilers:
-            config = f"{compiler}-{opt}"
-            all_groups_data[config] = group_hierarchical_benchmarks(results.get(config, {}))
+    all_groups_stats = {}
+    for config in configs:
+        all_groups_data[config] = group_hierarchical_benchmarks(results.get(config, {}))
+        all_groups_stats[config] = group_hierarchical_benchmarks((stats or {}).get(config, {}))
     
     # Get all unique group names across all configs
     all_groups = set()
     for groups in all_groups_data.values():
         all_groups.update(groups.keys())
-    all_groups = sorted(all_groups)
+    all_groups = sorted(all_groups, key=natural_key)
     
     if not all_groups:
         return "No benchmarks found.\n"
@@ -226,7 +471,7 @@ def generate_hierarchical_tables(results: Dict[str, Dict[str, str]]) -> str:
         for groups in all_groups_data.values():
             if group in groups:
                 all_containers.update(groups[group].keys())
-        all_containers = sorted(all_containers)
+        all_containers = sorted(all_containers, key=natural_key)
         
         if not all_containers:
             continue
@@ -234,67 +479,36 @@ def generate_hierarchical_tables(results: Dict[str, Dict[str, str]]) -> str:
         # Add group header
         md += f"## {group}\n\n"
         
-        # Calculate column widths
-        max_container_width = max(len(c) for c in all_containers)
-        max_container_width = max(max_container_width, len("Container"))
-        
-        # Collect values for each config
-        all_columns = {}
-        for opt in opt_levels:
-            for compiler in compilers:
-                config = f"{compiler}-{opt}"
-                column_values = []
-                group_data = all_groups_data[config].get(group, {})
-                for container in all_containers:
-                    value = group_data.get(container, None)
-                    column_values.append(value if value else "N/A")
-                # Normalize precision
-                all_columns[config] = normalize_precision(column_values)
-        
-        # Calculate max width for each column
-        column_widths = {}
-        for config in all_columns:
-            max_width = max(len(v) for v in all_columns[config])
-            max_width = max(max_width, len(config))
-            column_widths[config] = max_width
-        
-        # Build header
-        md += f"| {'Container':<{max_container_width}} "
-        for opt in opt_levels:
-            for compiler in compilers:
-                config = f"{compiler}-{opt}"
-                md += f"| {config:>{column_widths[config]}} "
-        md += "|\n"
-        
-        # Build separator
-        md += f"|{'-' * (max_container_width + 2)}"
-        for opt in opt_levels:
-            for compiler in compilers:
-                config = f"{compiler}-{opt}"
-                md += f"|{'-' * (column_widths[config] + 2)}"
-        md += "|\n"
-        
-        # Build data rows
-        for i, container in enumerate(all_containers):
-            md += f"| {container:<{max_container_width}} "
-            for opt in opt_levels:
-                for compiler in compilers:
-                    config = f"{compiler}-{opt}"
-                    value = all_columns[config][i]
-                    md += f"| {value:>{column_widths[config]}} "
-            md += "|\n"
+        group_data = {config: all_groups_data[config].get(group, {}) for config in configs}
+        group_stats = {config: all_groups_stats[config].get(group, {}) for config in configs}
+        md += generate_table("Container", all_containers, configs, group_data, group_stats if stats else None)
         
         md += "\n"
     
     return md
 
 
-def generate_summary(log_path: Path) -> str:
-    """Generate summary markdown from benchmark log."""
-    results = parse_benchmark_log(log_path)
+def generate_run_metadata(records: List[Dict]) -> str:
+    """List compiler version, CPU, governor and commit of each configuration."""
+    metadata = {}
+    for record in records:
+        metadata[config_label(record)] = record
+    
+    md = "**Runs**:\n\n"
+    for config in order_configs(metadata.keys()):
+        record = metadata[config]
+        md += (f"- {config}: {record.get('compiler_version') or 'unknown version'}, "
+               f"CPU {record.get('cpu') or 'unknown'}, governor {record.get('governor') or 'unknown'}, "
+               f"commit {record.get('commit') or 'unknown'}\n")
+    return md + "\n"
+
+
+def generate_summary(records: List[Dict]) -> str:
+    """Generate summary markdown from a project's store records."""
+    results, counters, stats = load_results(records)
     
     if not results:
-        return "# Benchmark Summary\n\nNo O3 results found.\n"
+        return "# Benchmark Summary\n\nNo results found.\n"
     
     # Get all benchmark names
     all_benchmarks = set()
@@ -306,33 +520,55 @@ def generate_summary(log_path: Path) -> str:
     
     # Generate markdown
     md = "# Benchmark Summary\n\n"
-    md += f"**Optimization Levels**: O3, O2, O1, O0\n\n"
+    md += f"**Configurations**: {', '.join(order_configs(results.keys()))}\n\n"
     md += f"**Naming Pattern**: {pattern}\n\n"
+    md += generate_run_metadata(records)
+    
+    if has_repetitions(stats):
+        repetitions = max(stat['n'] for benchmarks in stats.values() for stat in benchmarks.values())
+        md += f"**Repetitions**: {repetitions} (median time ± half-width of its 95% confidence interval; CPU time, real time for threaded and UseRealTime() benchmarks)\n\n"
+        md += "`*` fastest in column, `~` interval overlaps the fastest (not significant), "
+        md += "unmarked: significantly slower\n\n"
     
     if pattern == 'hierarchical':
-        md += generate_hierarchical_tables(results)
+        md += generate_hierarchical_tables(results, stats)
     else:
-        md += generate_simple_table(results)
+        md += generate_simple_table(results, stats)
+    
+    pgo = generate_pgo_comparison(stats)
+    if pgo:
+        md += "\n" + pgo
+    
+    if has_repetitions(stats):
+        md += "\n" + generate_outlier_list(stats)
+    
+    if counters:
+        md += "\n" + generate_counter_tables(results, counters)
     
     return md
 
 
 def main():
     if len(sys.argv) != 2:
-        print(f"Usage: {sys.argv[0]} <path_to_benchmark.log>")
+        print(f"Usage: {sys.argv[0]} <project_results_dir>")
+        print(f"Example: {sys.argv[0]} .benchmarks/exception")
         sys.exit(1)
     
-    log_path = Path(sys.argv[1])
+    project_dir = Path(sys.argv[1])
+    # Accept the path of the project's benchmark.log as well
+    if project_dir.name == "benchmark.log":
+        project_dir = project_dir.parent
     
-    if not log_path.exists():
-        print(f"Error: File not found: {log_path}")
+    store_path = project_dir.parent / STORE_NAME
+    if not store_path.exists():
+        print(f"Error: File not found: {store_path} (run: python3 perfection_results.py merge)")
         sys.exit(1)
     
     # Generate summary
-    summary = generate_summary(log_path)
+    summary = generate_summary(load_store(store_path, project_dir.name))
     
-    # Write to summary.md in same directory
-    output_path = log_path.parent / "summary.md"
+    # Write to summary.md in the project's results directory
+    output_path = project_dir / "summary.md"
     with open(output_path, 'w') as f:
         f.write(summary)
     
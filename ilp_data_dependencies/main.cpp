@@ -1,6 +1,13 @@
 #include <random>
 #include <benchmark/benchmark.h>
 
+// Isa, cpu_supports(), PERFECTION_X86 and <immintrin.h>
+#include "../common/isa.h"
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+
 // Array of random numbers
 static constexpr size_t ARRAY_SIZE = 1024 * 1024; // 1M elements
 static int data[ARRAY_SIZE];
@@ -44,6 +51,101 @@ void prfct_swap_dependent() {
     }
 }
 
+// ========== EXPLICIT SIMD ==========
+// Hand-written vector versions of prfct_swap_independent: W pairs per step. The back
+// vector is reversed so lane k holds the partner of front lane k; the results are
+// stored swapped (and the back one reversed again). (a + b) / 2 rounds toward zero like
+// the scalar code: add the sign bit before the arithmetic shift.
+// prfct_swap_dependent has no SIMD version: every pair needs prev_avg of the previous
+// one, and the rounding division makes the chain impossible to split into lanes.
+// Dispatch: common/isa.h.
+
+#ifdef PERFECTION_X86
+// 4 x int32 per vector
+__attribute__((target("sse2")))
+void prfct_swap_independent_sse2() {
+    constexpr size_t W = 4;
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(front));
+        __m128i b = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(back)), _MM_SHUFFLE(0, 1, 2, 3));
+        __m128i sum = _mm_add_epi32(a, b);
+        __m128i avg = _mm_srai_epi32(_mm_add_epi32(sum, _mm_srli_epi32(sum, 31)), 1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(front), _mm_add_epi32(b, avg));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(back), _mm_shuffle_epi32(_mm_add_epi32(a, avg), _MM_SHUFFLE(0, 1, 2, 3)));
+    }
+}
+
+// 8 x int32 per vector
+__attribute__((target("avx2")))
+void prfct_swap_independent_avx2() {
+    constexpr size_t W = 8;
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(front));
+        __m256i b = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(back)), reverse);
+        __m256i sum = _mm256_add_epi32(a, b);
+        __m256i avg = _mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_srli_epi32(sum, 31)), 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(front), _mm256_add_epi32(b, avg));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(back), _mm256_permutevar8x32_epi32(_mm256_add_epi32(a, avg), reverse));
+    }
+}
+
+// 16 x int32 per vector
+__attribute__((target("avx512f")))
+void prfct_swap_independent_avx512() {
+    constexpr size_t W = 16;
+    const __m512i reverse = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        __m512i a = _mm512_loadu_si512(front);
+        __m512i b = _mm512_permutexvar_epi32(reverse, _mm512_loadu_si512(back));
+        __m512i sum = _mm512_add_epi32(a, b);
+        __m512i avg = _mm512_srai_epi32(_mm512_add_epi32(sum, _mm512_srli_epi32(sum, 31)), 1);
+        _mm512_storeu_si512(front, _mm512_add_epi32(b, avg));
+        _mm512_storeu_si512(back, _mm512_permutexvar_epi32(reverse, _mm512_add_epi32(a, avg)));
+    }
+}
+#endif
+
+#ifdef __cpp_lib_experimental_parallel_simd
+namespace stdx = std::experimental;
+
+// Portable SIMD (Parallelism TS v2) at the native width of the baseline flags (SSE2: 4 x int32).
+// The TS has no permute: the reversal is a generator the compiler has to turn into a shuffle.
+void prfct_swap_independent_experimental_simd() {
+    using V = stdx::native_simd<int>;
+    constexpr size_t W = V::size();
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        V a(front, stdx::element_aligned);
+        V loaded(back, stdx::element_aligned);
+        V b([&](auto lane) { return loaded[W - 1 - lane]; });
+        V avg = (a + b) / 2;
+        V swapped = a + avg;
+        (b + avg).copy_to(front, stdx::element_aligned);
+        V([&](auto lane) { return swapped[W - 1 - lane]; }).copy_to(back, stdx::element_aligned);
+    }
+}
+#endif
+
+using Kernel = void (*)();
+
+// Widest instruction set the CPU supports, chosen once at runtime
+Kernel select_independent_kernel() {
+#ifdef PERFECTION_X86
+    if (cpu_supports(Isa::AVX512)) return prfct_swap_independent_avx512;
+    if (cpu_supports(Isa::AVX2)) return prfct_swap_independent_avx2;
+    if (cpu_supports(Isa::SSE2)) return prfct_swap_independent_sse2;
+#endif
+    return prfct_swap_independent;
+}
+
 static void BM_independent(benchmark::State& state) {
     initialize_data();
     
@@ -62,7 +164,29 @@ static void BM_dependent(benchmark::State& state) {
     }
 }
 
+// Explicit SIMD kernel; skipped (reported as an error) when the CPU lacks the instruction set
+static void BM_independent_simd(benchmark::State& state, Kernel kernel, Isa isa) {
+    if (!cpu_supports(isa)) {
+        state.SkipWithError("instruction set not supported by this CPU");
+    }
+    initialize_data();
+    
+    for (auto _ : state) {
+        kernel();
+        benchmark::DoNotOptimize(data);
+    }
+}
+
 BENCHMARK(BM_independent);
 BENCHMARK(BM_dependent);
+#ifdef PERFECTION_X86
+BENCHMARK_CAPTURE(BM_independent_simd, sse2, prfct_swap_independent_sse2, Isa::SSE2);
+BENCHMARK_CAPTURE(BM_independent_simd, avx2, prfct_swap_independent_avx2, Isa::AVX2);
+BENCHMARK_CAPTURE(BM_independent_simd, avx512, prfct_swap_independent_avx512, Isa::AVX512);
+#endif
+#ifdef __cpp_lib_experimental_parallel_simd
+BENCHMARK_CAPTURE(BM_independent_simd, experimental, prfct_swap_independent_experimental_simd, Isa::Native);
+#endif
+BENCHMARK_CAPTURE(BM_independent_simd, dispatch, select_independent_kernel(), Isa::Native);
 
 BENCHMARK_MAIN();
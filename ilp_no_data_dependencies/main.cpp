@@ -1,6 +1,13 @@
 #include <random>
 #include <benchmark/benchmark.h>
 
+// Isa, cpu_supports(), PERFECTION_X86 and <immintrin.h>
+#include "../common/isa.h"
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+
 // Array of random numbers
 static constexpr size_t ARRAY_SIZE = 1024 * 1024; // 1M elements
 static int data[ARRAY_SIZE];
@@ -113,6 +120,87 @@ void prfct_swap_unrolled<32>() {
     }
 }
 
+// ========== EXPLICIT SIMD ==========
+// Hand-written vector versions of prfct_swap_sequential: load W elements from the front
+// and W from the back, reverse both vectors and store them swapped (dispatch: common/isa.h).
+
+#ifdef PERFECTION_X86
+// 4 x int32 per vector
+__attribute__((target("sse2")))
+void prfct_swap_sse2() {
+    constexpr size_t W = 4;
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(front));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(back));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(front), _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(back), _mm_shuffle_epi32(f, _MM_SHUFFLE(0, 1, 2, 3)));
+    }
+}
+
+// 8 x int32 per vector
+__attribute__((target("avx2")))
+void prfct_swap_avx2() {
+    constexpr size_t W = 8;
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(front));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(back));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(front), _mm256_permutevar8x32_epi32(b, reverse));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(back), _mm256_permutevar8x32_epi32(f, reverse));
+    }
+}
+
+// 16 x int32 per vector
+__attribute__((target("avx512f")))
+void prfct_swap_avx512() {
+    constexpr size_t W = 16;
+    const __m512i reverse = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        __m512i f = _mm512_loadu_si512(front);
+        __m512i b = _mm512_loadu_si512(back);
+        _mm512_storeu_si512(front, _mm512_permutexvar_epi32(reverse, b));
+        _mm512_storeu_si512(back, _mm512_permutexvar_epi32(reverse, f));
+    }
+}
+#endif
+
+#ifdef __cpp_lib_experimental_parallel_simd
+namespace stdx = std::experimental;
+
+// Portable SIMD (Parallelism TS v2) at the native width of the baseline flags (SSE2: 4 x int32).
+// The TS has no permute: the reversal is a generator the compiler has to turn into a shuffle.
+void prfct_swap_experimental_simd() {
+    using V = stdx::native_simd<int>;
+    constexpr size_t W = V::size();
+    for (size_t i = 0; i < ARRAY_SIZE / 2; i += W) {
+        int* front = data + i;
+        int* back = data + ARRAY_SIZE - i - W;
+        V f(front, stdx::element_aligned);
+        V b(back, stdx::element_aligned);
+        V([&](auto lane) { return b[W - 1 - lane]; }).copy_to(front, stdx::element_aligned);
+        V([&](auto lane) { return f[W - 1 - lane]; }).copy_to(back, stdx::element_aligned);
+    }
+}
+#endif
+
+using Kernel = void (*)();
+
+// Widest instruction set the CPU supports, chosen once at runtime
+Kernel select_swap_kernel() {
+#ifdef PERFECTION_X86
+    if (cpu_supports(Isa::AVX512)) return prfct_swap_avx512;
+    if (cpu_supports(Isa::AVX2)) return prfct_swap_avx2;
+    if (cpu_supports(Isa::SSE2)) return prfct_swap_sse2;
+#endif
+    return prfct_swap_sequential;
+}
+
 static void BM_sequential(benchmark::State& state) {
     initialize_data();
     
@@ -139,7 +227,29 @@ static void BM_unrolled(benchmark::State& state) {
     state.SetLabel("unroll_" + std::to_string(unroll_factor));
 }
 
+// Explicit SIMD kernel; skipped (reported as an error) when the CPU lacks the instruction set
+static void BM_simd(benchmark::State& state, Kernel kernel, Isa isa) {
+    if (!cpu_supports(isa)) {
+        state.SkipWithError("instruction set not supported by this CPU");
+    }
+    initialize_data();
+    
+    for (auto _ : state) {
+        kernel();
+        benchmark::DoNotOptimize(data);
+    }
+}
+
 BENCHMARK(BM_sequential);
 BENCHMARK(BM_unrolled)->Arg(4)->Arg(8)->Arg(16)->Arg(32);
+#ifdef PERFECTION_X86
+BENCHMARK_CAPTURE(BM_simd, sse2, prfct_swap_sse2, Isa::SSE2);
+BENCHMARK_CAPTURE(BM_simd, avx2, prfct_swap_avx2, Isa::AVX2);
+BENCHMARK_CAPTURE(BM_simd, avx512, prfct_swap_avx512, Isa::AVX512);
+#endif
+#ifdef __cpp_lib_experimental_parallel_simd
+BENCHMARK_CAPTURE(BM_simd, experimental, prfct_swap_experimental_simd, Isa::Native);
+#endif
+BENCHMARK_CAPTURE(BM_simd, dispatch, select_swap_kernel(), Isa::Native);
 
 BENCHMARK_MAIN();
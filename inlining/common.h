@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define FORCE_INLINE __attribute__((always_inline)) inline
+    #define NOINLINE __attribute__((noinline))
+#endif
+
+// =============================================================================
+// Call Chains for the Inlining Budget Study
+// =============================================================================
+// A chain is Depth levels of the same function template, each running a Body-step
+// mix of its argument before calling the next level. Many call sites invoke the same
+// chain: inlined, every site gets its own copy (code ~ Sites x Depth x Body steps);
+// out of line, all sites share one. The policy decides who makes the call:
+// - AlwaysInline: always_inline on every level
+// - Default: plain inline functions, the compiler's budget decides (-finline-limit,
+//   -mllvm -inline-threshold, LTO)
+// - NoInline: noinline on every level
+// - CrossTU: levels defined in levels.cpp, inlinable into the call sites only with LTO
+
+struct AlwaysInline {};
+struct Default {};
+struct NoInline {};
+struct CrossTU {};
+
+// One step: add, shift, xor (~4 instructions, 2-cycle dependency). Constants differ
+// per level and step, so levels do not fold into each other or get merged.
+template<int Level, int Step>
+constexpr uint32_t step_constant() {
+    return (static_cast<uint32_t>(Level) * 0x9E3779B1u + static_cast<uint32_t>(Step) * 0x85EBCA6Bu) | 1u;
+}
+
+template<int Level, int... Steps>
+FORCE_INLINE uint64_t mix_steps(uint64_t x, std::integer_sequence<int, Steps...>) {
+    ((x = (x + step_constant<Level, Steps>()) ^ (x >> (Steps % 29 + 3))), ...);
+    return x;
+}
+
+template<int Level, int Body>
+FORCE_INLINE uint64_t mix(uint64_t x) {
+    return mix_steps<Level>(x, std::make_integer_sequence<int, Body>{});
+}
+
+// Level<Policy, Depth, Body>::prfct_run(x): mix, then call level Depth - 1
+template<typename Policy, int Depth, int Body>
+struct Level;
+
+template<int Depth, int Body>
+struct Level<AlwaysInline, Depth, Body> {
+    FORCE_INLINE static uint64_t prfct_run(uint64_t x) {
+        x = mix<Depth, Body>(x);
+        if constexpr (Depth > 1) {
+            x = Level<AlwaysInline, Depth - 1, Body>::prfct_run(x);
+        }
+        return x;
+    }
+};
+
+template<int Depth, int Body>
+struct Level<Default, Depth, Body> {
+    static inline uint64_t prfct_run(uint64_t x) {
+        x = mix<Depth, Body>(x);
+        if constexpr (Depth > 1) {
+            x = Level<Default, Depth - 1, Body>::prfct_run(x);
+        }
+        return x;
+    }
+};
+
+template<int Depth, int Body>
+struct Level<NoInline, Depth, Body> {
+    NOINLINE static uint64_t prfct_run(uint64_t x) {
+        x = mix<Depth, Body>(x);
+        if constexpr (Depth > 1) {
+            x = Level<NoInline, Depth - 1, Body>::prfct_run(x);
+        }
+        return x;
+    }
+};
+
+// Defined and explicitly instantiated in levels.cpp
+template<int Depth, int Body>
+struct Level<CrossTU, Depth, Body> {
+    static uint64_t prfct_run(uint64_t x);
+};
+
+// Chain shapes (depth x body steps) instantiated for every policy; levels.cpp
+// instantiates the CrossTU chains of the same list
+#define PERFECTION_INLINING_CHAINS(X) \
+    X(2, 4)                           \
+    X(2, 16)                          \
+    X(8, 4)                           \
+    X(8, 16)
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""
+Put code size, instruction-cache misses and time of the inlining call chains side by side.
+
+Reads Chain/depth<D>_body<B>_<S>sites/<Policy> from .benchmarks/results.json and, per
+configuration, the symbol sizes of the inlining binary it ran (.build/inlining/<config>/inlining):
+the benchmark's hot function prfct_sites<Policy, D, B, S> plus the out-of-line levels
+Level<Policy, d, B>::prfct_run it may call (shared by all site counts).
+
+    | Chain          | Sites | Policy       | Code     | ns/call | L1i misses/call |
+    |----------------|-------|--------------|----------|---------|-----------------|
+    | depth8_body16  |    64 | AlwaysInline | 101.2 KB |    9.41 |            0.82 |
+    ...
+
+Instruction-cache misses need hardware counters, e.g.
+PERFECTION_COUNTERS=CYCLES,INSTRUCTIONS,perf::PERF_COUNT_HW_CACHE_L1I:READ:MISS; any counter
+whose name contains L1I or ICACHE is used. Without counters the column shows '-'.
+A crossover table lists, per chain, the first site count where AlwaysInline is slower than NoInline.
+Output: .benchmarks/inlining/inlining_report.md
+
+Usage:
+    python3 inlining/inlining_report.py [results.json]
+"""
+
+import re
+import subprocess
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+ROOT_DIR = Path(__file__).resolve().parent.parent
+sys.path.insert(0, str(ROOT_DIR))
+
+from extract_disassembly import read_symbols  # noqa: E402
+from generate_summary import order_config_names, project_report_main  # noqa: E402
+from perfection_results import measured_time_ns, median  # noqa: E402
+
+
+PROJECT = "inlining"
+
+# Inputs per benchmark iteration (BATCH in inlining/main.cpp)
+BATCH = 256
+
+POLICIES = ['AlwaysInline', 'Default', 'NoInline', 'CrossTU']
+
+# 'Chain/depth8_body16_64sites/NoInline'
+CHAIN_RE = re.compile(r'^Chain/depth(\d+)_body(\d+)_(\d+)sites/(\w+)$')
+
+# 'unsigned long prfct_sites<NoInline, 8, 16, 64>(unsigned long const*, unsigned long)'
+SITES_SYMBOL_RE = re.compile(r'prfct_sites<(\w+), (\d+), (\d+), (\d+)>')
+
+# 'Level<NoInline, 8, 16>::prfct_run(unsigned long)'
+LEVEL_SYMBOL_RE = re.compile(r'Level<(\w+), (\d+), (\d+)>::prfct_run')
+
+Key = Tuple[str, int, int, int]
+
+
+def format_bytes(size: float) -> str:
+    """512 -> '512 B', 103629 -> '101.2 KB'."""
+    if size < 1024:
+        return f"{size:.0f} B"
+    if size < 1024 * 1024:
+        return f"{size / 1024:.1f} KB"
+    return f"{size / (1024 * 1024):.1f} MB"
+
+
+def icache_counter(counters: Dict) -> Optional[float]:
+    """Value of the first L1i-miss counter of a record (per iteration), if any."""
+    for name, value in counters.items():
+        upper = name.upper()
+        if 'L1I' in upper or 'ICACHE' in upper:
+            return value
+    return None
+
+
+def collect(records: List[Dict]) -> Dict[str, Dict[Key, Dict]]:
+    """
+    Median time and L1i misses per chain call for each config and benchmark.
+    
+    Returns: {'gcc_O3': {('NoInline', 8, 16, 64): {'ns': 9.4, 'misses': 0.8 or None}}}
+    """
+    samples = {}
+    for record in records:
+        match = CHAIN_RE.match(record['benchmark'])
+        if not match:
+            continue
+        depth, body, sites, policy = int(match[1]), int(match[2]), int(match[3]), match[4]
+        calls = BATCH * sites
+        entry = samples.setdefault(record['config'], {}).setdefault((policy, depth, body, sites),
+                                                                     {'ns': [], 'misses': []})
+        entry['ns'].append(measured_time_ns(record) / calls)
+        misses = icache_counter(record['counters'])
+        if misses is not None:
+            entry['misses'].append(misses / calls)
+    
+    return {config: {key: {'ns': median(values['ns']),
+                           'misses': median(values['misses']) if values['misses'] else None}
+                     for key, values in benchmarks.items()}
+            for config, benchmarks in samples.items()}
+
+
+def code_sizes(binary: Path) -> Tuple[Dict[Key, int], int]:
+    """
+    Code bytes per benchmark and the binary's .text size (empty / 0 if the binary is missing).
+    
+    A benchmark's code is its prfct_sites<> instantiation plus every out-of-line level of its
+    policy and body with depth <= D (levels inlined into the hot function have no symbol).
+    """
+    if not binary.exists():
+        return {}, 0
+    
+    hot = {}
+    levels = {}
+    for name, size in read_symbols(str(binary), 'prfct_').values():
+        match = SITES_SYMBOL_RE.search(name)
+        if match:
+            hot[(match[1], int(match[2]), int(match[3]), int(match[4]))] = size
+            continue
+        match = LEVEL_SYMBOL_RE.search(name)
+        if match:
+            levels[(match[1], int(match[2]), int(match[3]))] = size
+    
+    sizes = {}
+    for (policy, depth, body, sites), size in hot.items():
+        sizes[(policy, depth, body, sites)] = size + sum(
+            level_size for (level_policy, level_depth, level_body), level_size in levels.items()
+            if level_policy == policy and level_body == body and level_depth <= depth)
+    
+    text = 0
+    output = subprocess.run(['size', '-A', str(binary)], capture_output=True, text=True).stdout
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0] == '.text':
+            text = int(parts[1])
+    return sizes, text
+
+
+def host_icache() -> Optional[str]:
+    """L1 instruction cache size of cpu0 from sysfs, e.g. '32K'."""
+    for index in sorted(Path('/sys/devices/system/cpu/cpu0/cache').glob('index*')):
+        try:
+            if (index / 'type').read_text().strip() == 'Instruction':
+                return (index / 'size').read_text().strip()
+        except OSError:
+            continue
+    return None
+
+
+def crossover(results: Dict[Key, Dict]) -> Dict[Tuple[int, int], Optional[int]]:
+    """Per (depth, body): first site count where AlwaysInline is slower than NoInline (None: never)."""
+    shapes = sorted({(depth, body) for _, depth, body, _ in results})
+    crossings = {}
+    for depth, body in shapes:
+        crossings[(depth, body)] = None
+        site_counts = sorted({sites for _, d, b, sites in results if (d, b) == (depth, body)})
+        for sites in site_counts:
+            inlined = results.get(('AlwaysInline', depth, body, sites))
+            called = results.get(('NoInline', depth, body, sites))
+            if inlined and called and inlined['ns'] > called['ns']:
+                crossings[(depth, body)] = sites
+                break
+    return crossings
+
+
+def generate_report(records: List[Dict], build_dir: Path) -> str:
+    """Markdown report: one table per configuration, then the crossover table."""
+    results = collect(records)
+    
+    md = "# Inlining Budget\n\n"
+    icache = host_icache()
+    if icache:
+        md += f"**Host L1i (sysfs)**: {icache}\n\n"
+    if not results:
+        return md + "No Chain/ results found (run: ./benchmarks.sh inlining).\n"
+    
+    configs = order_config_names(results)
+    
+    for config in configs:
+        sizes, text = code_sizes(build_dir / config / PROJECT)
+        md += f"## {config}\n\n"
+        if text:
+            md += f"Binary .text: {format_bytes(text)}\n\n"
+        md += "| Chain          | Sites | Policy       | Code     | ns/call | L1i misses/call |\n"
+        md += "|----------------|-------|--------------|----------|---------|-----------------|\n"
+        keys = sorted(results[config], key=lambda k: (k[1], k[2], k[3], POLICIES.index(k[0])
+                                                      if k[0] in POLICIES else len(POLICIES)))
+        for key in keys:
+            policy, depth, body, sites = key
+            result = results[config][key]
+            code = format_bytes(sizes[key]) if key in sizes else "-"
+            misses = f"{result['misses']:.3f}" if result['misses'] is not None else "-"
+            chain = f"depth{depth}_body{body}"
+            md += f"| {chain:<14} | {sites:>5} | {policy:<12} | {code:>8} | {result['ns']:7.2f} | {misses:>15} |\n"
+        md += "\n"
+    
+    md += "## Crossover\n\n"
+    md += "First site count where AlwaysInline is slower than NoInline (`-`: inlining never lost).\n\n"
+    md += "| Config | " + " | ".join(f"depth{d}_body{b}" for d, b in sorted(crossover(results[configs[0]]))) + " |\n"
+    md += "|--------|" + "|".join("---" for _ in crossover(results[configs[0]])) + "|\n"
+    for config in configs:
+        crossings = crossover(results[config])
+        cells = [str(sites) if sites is not None else "-" for _, sites in sorted(crossings.items())]
+        md += f"| {config} | " + " | ".join(cells) + " |\n"
+    return md
+
+
+def main():
+    build_dir = ROOT_DIR / '.build' / PROJECT
+    project_report_main(PROJECT, "inlining_report.md", lambda records: generate_report(records, build_dir))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,18 @@
+#include "common.h"
+
+// CrossTU chains: the call sites in main.cpp only see the declaration, so without
+// LTO every site calls the top level out of line. Levels of one chain are in this
+// translation unit and may still be inlined into each other by the normal budget.
+
+template<int Depth, int Body>
+uint64_t Level<CrossTU, Depth, Body>::prfct_run(uint64_t x) {
+    x = mix<Depth, Body>(x);
+    if constexpr (Depth > 1) {
+        x = Level<CrossTU, Depth - 1, Body>::prfct_run(x);
+    }
+    return x;
+}
+
+#define INSTANTIATE_CHAIN(depth, body) template struct Level<CrossTU, depth, body>;
+PERFECTION_INLINING_CHAINS(INSTANTIATE_CHAIN)
+#undef INSTANTIATE_CHAIN
@@ -1,10 +1,9 @@
 #include <random>
+#include <string>
+#include <vector>
 #include <benchmark/benchmark.h>
 
-#if defined(__GNUC__) || defined(__clang__)
-    #define FORCE_INLINE __attribute__((always_inline)) inline
-    #define NOINLINE __attribute__((noinline))
-#endif
+#include "common.h"
 
 static char random_data[1024*1024];
 
@@ -61,4 +60,74 @@ static void BM_process_noinline(benchmark::State& state) {
 BENCHMARK(BM_process_inlined);
 BENCHMARK(BM_process_noinline);
 
+// ========== CALL CHAINS: DEPTH x BODY x CALL SITES ==========
+
+// Inputs per iteration; every input runs through all call sites
+static constexpr size_t BATCH = 256;
+
+// Call site counts per chain: inlined, the largest shapes pass the L1i (32KB on most x86)
+// at 8 sites and L2-sized code at 64
+static constexpr int SITES[] = {1, 8, 64};
+
+// Sites are independent chains (as calls from unrelated code would be): out-of-order
+// execution overlaps them whether they are inlined or called, so once the inlined
+// copies no longer fit the instruction caches, the front end limits throughput
+template<typename Policy, int Depth, int Body, int... Sites>
+FORCE_INLINE uint64_t run_sites(uint64_t x, std::integer_sequence<int, Sites...>) {
+    return (Level<Policy, Depth, Body>::prfct_run(x + Sites) + ...);
+}
+
+// The hot function of one benchmark: its size in the binary is the inlined code
+template<typename Policy, int Depth, int Body, int Sites>
+NOINLINE uint64_t prfct_sites(const uint64_t* input, size_t count) {
+    uint64_t acc = 0;
+    for (size_t i = 0; i < count; ++i) {
+        acc += run_sites<Policy, Depth, Body>(input[i], std::make_integer_sequence<int, Sites>{});
+    }
+    return acc;
+}
+
+// items_per_second: chain calls per second
+template<typename Policy, int Depth, int Body, int Sites>
+static void BM_chain(benchmark::State& state) {
+    std::vector<uint64_t> input(BATCH);
+    for (size_t i = 0; i < BATCH; ++i) {
+        input[i] = i * 0x9E3779B97F4A7C15ull;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(prfct_sites<Policy, Depth, Body, Sites>(input.data(), input.size()));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(BATCH) * Sites);
+}
+
+// Names: Chain/depth<D>_body<B>_<S>sites/<Policy>, one summary table per chain shape
+// and site count comparing the policies (inlining/inlining_report.py adds code size)
+template<int Depth, int Body, int Sites>
+static void register_chain() {
+    std::string group = "Chain/depth" + std::to_string(Depth) + "_body" + std::to_string(Body) + "_" +
+                        std::to_string(Sites) + "sites/";
+    benchmark::RegisterBenchmark((group + "AlwaysInline").c_str(), BM_chain<AlwaysInline, Depth, Body, Sites>);
+    benchmark::RegisterBenchmark((group + "Default").c_str(), BM_chain<Default, Depth, Body, Sites>);
+    benchmark::RegisterBenchmark((group + "NoInline").c_str(), BM_chain<NoInline, Depth, Body, Sites>);
+    benchmark::RegisterBenchmark((group + "CrossTU").c_str(), BM_chain<CrossTU, Depth, Body, Sites>);
+}
+
+template<int Depth, int Body>
+static void register_shape() {
+    static_assert(sizeof(SITES) / sizeof(SITES[0]) == 3, "register_shape lists the SITES entries");
+    register_chain<Depth, Body, SITES[0]>();
+    register_chain<Depth, Body, SITES[1]>();
+    register_chain<Depth, Body, SITES[2]>();
+}
+
+static bool register_chains() {
+#define REGISTER_SHAPE(depth, body) register_shape<depth, body>();
+    PERFECTION_INLINING_CHAINS(REGISTER_SHAPE)
+#undef REGISTER_SHAPE
+    return true;
+}
+
+static const bool registered = register_chains();
+
 BENCHMARK_MAIN();
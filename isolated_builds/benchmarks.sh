@@ -6,6 +6,8 @@
 set -e
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(dirname "${SCRIPT_DIR}")"
+source "${PROJECT_ROOT}/build_common.sh"
 BUILD_DIR="${SCRIPT_DIR}/.build"
 BENCHMARKS_DIR="${SCRIPT_DIR}/.benchmarks"
 
@@ -24,11 +26,17 @@ if [ ! -d "${PROJECT_BUILD_DIR}" ]; then
     exit 1
 fi
 
+# Multithreaded projects get all PERFECTION_THREADED_CPUS, the others one core
+PROJECT_CPUS=$(project_bench_cpus "${PROJECT_NAME}")
+
 OUTPUT_DIR="${BENCHMARKS_DIR}/${PROJECT_NAME}"
 mkdir -p "${OUTPUT_DIR}"
 
 LOG_FILE="${OUTPUT_DIR}/benchmark.log"
 > "${LOG_FILE}"
+# Google Benchmark JSON per configuration, merged into .benchmarks/results.json
+RUNS_DIR="${OUTPUT_DIR}/runs"
+rm -rf "${RUNS_DIR}"
 
 echo "============================================"
 echo "Running Docker-built benchmarks for: ${PROJECT_NAME}"
@@ -43,8 +51,13 @@ for binary in "${PROJECT_BUILD_DIR}"/*/"${PROJECT_NAME}"; do
         
         echo "========== ${config} ==========" | tee -a "${LOG_FILE}"
         
+        # Config is <compiler image>_<opt level>, e.g. gcc_13_O3
+        mkdir -p "${RUNS_DIR}/${config}"
+        CONTEXT_ARG=$(benchmark_context_arg "${PROJECT_ROOT}" "$(dirname "${binary}")" "${config%_*}" "${config##*_}" "${PROJECT_CPUS}")
+        
         # Run binary on host with minimal output (suppress system info)
-        "${binary}" --benchmark_color=false --benchmark_counters_tabular=false 2>&1 | \
+        run_pinned "${PROJECT_CPUS}" "${binary}" --benchmark_color=false --benchmark_counters_tabular=false "${CONTEXT_ARG}" \
+            --benchmark_out="${RUNS_DIR}/${config}/${PROJECT_NAME}.json" --benchmark_out_format=json 2>&1 | \
             grep -v "^Running " | \
             grep -v "^Run on " | \
             grep -v "^CPU Caches:" | \
@@ -57,6 +70,8 @@ for binary in "${PROJECT_BUILD_DIR}"/*/"${PROJECT_NAME}"; do
     fi
 done
 
+python3 "${PROJECT_ROOT}/perfection_results.py" merge "${BENCHMARKS_DIR}"
+
 echo "============================================"
 echo "Done! Results saved to: ${LOG_FILE}"
 echo "============================================"
@@ -10,6 +10,9 @@ SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 PROJECT_ROOT="$(dirname "${SCRIPT_DIR}")"
 BUILD_DIR="${SCRIPT_DIR}/.build"
 
+# Shared helpers (build keys: unchanged configurations are skipped)
+source "${PROJECT_ROOT}/build_common.sh"
+
 if [ $# -ne 1 ]; then
     echo "Usage: $0 <project_name>"
     echo "Example: $0 ilp_data_dependencies"
@@ -53,11 +56,21 @@ COMPILERS=(
 )
 
 OPT_LEVELS=("O0" "O1" "O2" "O3")
+SKIPPED=0
+
+# Same standard as the native builds (perfection_setup_project); the images default to C++14 up to gcc 10 / clang 15
+CXX_STANDARD="-std=c++17"
+
+# Sources of the project binary: main.cpp plus the files its CMakeLists.txt adds with
+# target_sources(<project> PRIVATE ...), e.g. noexcept/callees.cpp, inlining/levels.cpp
+SOURCES="main.cpp $(sed -n "s/^[[:space:]]*target_sources(${PROJECT_NAME}[[:space:]]\+PRIVATE[[:space:]]\+\([^)]*\)).*/\1/p" \
+    "${PROJECT_DIR}/CMakeLists.txt" | tr '\n' ' ')"
 
 echo "============================================"
 echo "Historical build for project: ${PROJECT_NAME}"
 echo "Compilers: ${#COMPILERS[@]} versions"
 echo "Optimization levels: ${OPT_LEVELS[@]}"
+echo "Sources: ${SOURCES}"
 echo "Total builds: $((${#COMPILERS[@]} * ${#OPT_LEVELS[@]}))"
 echo "============================================"
 echo ""
@@ -74,6 +87,17 @@ for compiler_image in "${COMPILERS[@]}"; do
         
         mkdir -p "${OUTPUT_DIR}"
         
+        # Skip configurations whose sources and compiler image are unchanged since the last build
+        # (the image ID changes whenever the image tag is re-pulled)
+        IMAGE_ID=$(docker image inspect --format '{{.Id}}' "${compiler_image}" 2>/dev/null || echo "${compiler_image}")
+        KEY=$(build_key "${PROJECT_DIR}" "${IMAGE_ID}" "-${opt_level}" "${CXX_STANDARD}")
+        if build_is_cached "${OUTPUT_DIR}" "${KEY}" "${OUTPUT_BIN}"; then
+            echo "= ${compiler_image} -${opt_level} unchanged, skipping"
+            SKIPPED=$((SKIPPED + 1))
+            continue
+        fi
+        rm -f "${OUTPUT_DIR}/${BUILD_KEY_FILE}" "${OUTPUT_BIN}"
+        
         echo "============================================"
         echo "Building with ${compiler_image} -${opt_level}..."
         echo "Output: ${OUTPUT_BIN}"
@@ -143,7 +167,7 @@ for compiler_image in "${COMPILERS[@]}"; do
             -v "${PROJECT_ROOT}:/work" \
             -w "/work/${PROJECT_NAME}" \
             "${compiler_image}" \
-            ${COMPILER_CMD} -${opt_level} main.cpp \
+            ${COMPILER_CMD} ${CXX_STANDARD} -${opt_level} ${SOURCES} \
                 -I../3rdparty/src/benchmark/include \
                 ${CONTAINER_BENCHMARK_LIB} \
                 -lpthread \
@@ -151,6 +175,7 @@ for compiler_image in "${COMPILERS[@]}"; do
             2>&1 | grep -v "warning:" || true
         
         if [ -f "${OUTPUT_BIN}" ]; then
+            echo "${KEY}" > "${OUTPUT_DIR}/${BUILD_KEY_FILE}"
             echo "✓ Built successfully"
         else
             echo "✗ Build failed"
@@ -161,6 +186,7 @@ done
 
 echo "============================================"
 echo "Done! Binaries saved to: ${BUILD_DIR}/${PROJECT_NAME}/"
+echo "Unchanged configurations skipped: ${SKIPPED} (PERFECTION_REBUILD=1 forces a rebuild)"
 echo "============================================"
 echo ""
 echo "To run benchmarks:"
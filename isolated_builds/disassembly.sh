@@ -5,6 +5,7 @@
 set -e
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(dirname "${SCRIPT_DIR}")"
 BUILD_DIR="${SCRIPT_DIR}/.build"
 DISASM_DIR="${SCRIPT_DIR}/.disassembly"
 
@@ -38,38 +39,14 @@ for binary in "${PROJECT_BUILD_DIR}"/*/"${PROJECT_NAME}"; do
         
         echo "Processing ${config}..."
         
-        # Full disassembly
-        objdump -d -C "${binary}" > "${OUTPUT_DIR}/full_${config}.dis"
-        
-        # Extract prfct_ functions
         > "${disasm_file}"
         echo "Project: ${PROJECT_NAME}" >> "${disasm_file}"
         echo "Configuration: ${config}" >> "${disasm_file}"
         echo "" >> "${disasm_file}"
         
-        FUNCTIONS=$(grep -E '^[0-9a-f]+ <.*prfct_.*>' "${OUTPUT_DIR}/full_${config}.dis" | \
-                    sed 's/^[0-9a-f]\+ <\(.*\)>:/\1/')
-        
-        while IFS= read -r funcname; do
-            if [ -n "$funcname" ]; then
-                echo "========== $funcname ==========" >> "${disasm_file}"
-                in_function=0
-                while IFS= read -r line; do
-                    if [[ "$line" == *"<${funcname}>:"* ]]; then
-                        in_function=1
-                    fi
-                    if [ $in_function -eq 1 ]; then
-                        echo "$line" | sed 's/^[ ]*[0-9a-f]\+://' >> "${disasm_file}"
-                        if [ -z "$line" ]; then
-                            break
-                        fi
-                    fi
-                done < "${OUTPUT_DIR}/full_${config}.dis"
-                echo "" >> "${disasm_file}"
-            fi
-        done <<< "$FUNCTIONS"
+        # Extract prfct_ functions with code size, instruction count and loops
+        python3 "${PROJECT_ROOT}/extract_disassembly.py" "${binary}" >> "${disasm_file}"
         
-        rm "${OUTPUT_DIR}/full_${config}.dis"
         echo "Saved to: ${disasm_file}"
     fi
 done
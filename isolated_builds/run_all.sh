@@ -6,7 +6,7 @@ set -e
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 
-PROJECTS=("inlining" "virtual" "noexcept" "exception" "cache_locality" "branch_prediction" "ilp_no_data_dependencies" "ilp_data_dependencies")
+PROJECTS=("inlining" "virtual" "noexcept" "exception" "cache_locality" "branch_prediction" "ilp_no_data_dependencies" "ilp_data_dependencies" "memory_bandwidth" "soa_aos" "dispatch")
 
 echo "============================================"
 echo "Running all isolated builds tasks"
@@ -0,0 +1,129 @@
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+// Thread sweep: MAX_THREADS, max_threads()
+#include "../common/threads.h"
+
+// Shared array swept by all threads: 256MB, beyond the last-level cache of most hosts,
+// so the sum kernels measure DRAM bandwidth
+static constexpr size_t WORKING_SET = 256 * 1024 * 1024;
+
+// Stride of the strided kernel in elements: one cache line (64B)
+static constexpr size_t STRIDE = 64 / sizeof(int);
+
+// Counter increments per thread and iteration
+static constexpr size_t INCREMENTS = 1024 * 1024;
+
+// Built once and shared read-only by every benchmark thread
+static const std::vector<int>& shared_data() {
+    static const std::vector<int> data = [] {
+        std::vector<int> values(WORKING_SET / sizeof(int));
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = static_cast<int>(i % 100) + 1;
+        }
+        return values;
+    }();
+    return data;
+}
+
+// Sequential access - full cache line utilization, hardware prefetching
+long long prfct_sum_sequential(const int* data, size_t size) {
+    long long sum = 0;
+    for (size_t i = 0; i < size; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+// Strided access - one element per cache line per pass, every line is fetched once per offset
+long long prfct_sum_strided(const int* data, size_t size, size_t stride) {
+    long long sum = 0;
+
+    // Process all elements by cycling through offsets
+    for (size_t offset = 0; offset < stride; ++offset) {
+        for (size_t i = offset; i < size; i += stride) {
+            sum += data[i];
+        }
+    }
+
+    return sum;
+}
+
+// Per-thread counters packed next to each other: 8 counters share one cache line,
+// so every increment invalidates the line in the other cores (false sharing)
+struct Counter {
+    std::atomic<uint64_t> value{0};
+};
+
+// Per-thread counters padded to a cache line each: no line is written by two threads
+struct alignas(64) PaddedCounter {
+    std::atomic<uint64_t> value{0};
+};
+
+// One counter slot per thread
+static Counter counters[MAX_THREADS];
+static PaddedCounter padded_counters[MAX_THREADS];
+
+// Relaxed load + store instead of fetch_add: plain moves, no locked instruction,
+// so the difference between the variants is only cache line ownership
+template <typename CounterT>
+void prfct_increment(CounterT& counter, size_t increments) {
+    for (size_t i = 0; i < increments; ++i) {
+        counter.value.store(counter.value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+// Each thread sums its own slice of the shared array; one iteration of all threads
+// covers the whole array. bytes_per_second is the aggregate over all threads.
+static void BM_sequential(benchmark::State& state) {
+    const std::vector<int>& data = shared_data();
+    const size_t slice = data.size() / static_cast<size_t>(state.threads());
+    const int* begin = data.data() + slice * static_cast<size_t>(state.thread_index());
+
+    for (auto _ : state) {
+        long long result = prfct_sum_sequential(begin, slice);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(slice * sizeof(int)));
+}
+
+static void BM_strided(benchmark::State& state) {
+    const std::vector<int>& data = shared_data();
+    const size_t slice = data.size() / static_cast<size_t>(state.threads());
+    const int* begin = data.data() + slice * static_cast<size_t>(state.thread_index());
+
+    for (auto _ : state) {
+        long long result = prfct_sum_strided(begin, slice, STRIDE);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(slice * sizeof(int)));
+}
+
+// Reports 'increments' per second, summed over all threads
+template <typename CounterT>
+static void BM_counters(benchmark::State& state, CounterT* slots) {
+    CounterT& counter = slots[state.thread_index()];
+
+    for (auto _ : state) {
+        prfct_increment(counter, INCREMENTS);
+    }
+    state.counters["increments"] = benchmark::Counter(static_cast<double>(INCREMENTS),
+                                                      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void BM_unpadded_counters(benchmark::State& state) {
+    BM_counters(state, counters);
+}
+
+static void BM_padded_counters(benchmark::State& state) {
+    BM_counters(state, padded_counters);
+}
+
+BENCHMARK(BM_sequential)->ThreadRange(1, max_threads())->UseRealTime();
+BENCHMARK(BM_strided)->ThreadRange(1, max_threads())->UseRealTime();
+BENCHMARK(BM_unpadded_counters)->ThreadRange(1, max_threads())->UseRealTime();
+BENCHMARK(BM_padded_counters)->ThreadRange(1, max_threads())->UseRealTime();
+
+BENCHMARK_MAIN();
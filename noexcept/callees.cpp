@@ -0,0 +1,13 @@
+#include "common.h"
+
+// Kept out of main.cpp: in the same translation unit GCC's IPA would discover that
+// prfct_callee_may_throw cannot throw and drop the caller's landing pads anyway
+// (LTO flag profiles still can)
+
+int prfct_callee_may_throw(int value) {
+    return value * 3 + 1;
+}
+
+int prfct_callee_noexcept(int value) noexcept {
+    return value * 3 + 1;
+}
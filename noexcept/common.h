@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define NOINLINE __attribute__((noinline))
+#endif
+
+// =============================================================================
+// Where noexcept Changes Generated Code
+// =============================================================================
+// noexcept only matters where code asks for it: std::move_if_noexcept in container
+// reallocation, the exception-safety branches of std::variant assignment, and the
+// landing pads a caller needs around calls that may throw.
+
+// Element types (the containers/vector elements, without its Boost/Abseil headers)
+
+// 24 bytes: copy and move are the same three stores
+struct Point {
+    double x, y, z;
+    Point() : x(0), y(0), z(0) {}
+    explicit Point(int val) : x(val), y(val), z(val) {}
+};
+
+// 256 bytes: copy and move are the same memcpy
+struct LargeStruct {
+    std::array<int, 64> data;
+    LargeStruct() { data.fill(0); }
+    explicit LargeStruct(int val) { data.fill(val); }
+};
+
+// 32 characters, past the small-string buffer: a copy allocates, a move takes the pointer
+struct HeapString {
+    std::string text;
+    HeapString() = default;
+    explicit HeapString(int val) : text(32, static_cast<char>('a' + val % 26)) {}
+};
+
+template<typename Element> struct ElementName;
+template<> struct ElementName<Point> { static constexpr const char* name = "Point"; };
+template<> struct ElementName<LargeStruct> { static constexpr const char* name = "LargeStruct"; };
+template<> struct ElementName<HeapString> { static constexpr const char* name = "String"; };
+
+// Element wrapper with user-provided copy and move: not trivially copyable (so
+// std::vector relocates element by element instead of memmove) and a move
+// constructor that is noexcept or not. Copy and move do the same work as the
+// wrapped type's, so any difference comes from which one the library picks.
+template<typename T, bool NoexceptMove>
+struct Movable {
+    T value;
+
+    Movable() = default;
+    explicit Movable(int val) : value(val) {}
+    Movable(const Movable& other) : value(other.value) {}
+    Movable(Movable&& other) noexcept(NoexceptMove) : value(std::move(other.value)) {}
+    Movable& operator=(const Movable& other) {
+        value = other.value;
+        return *this;
+    }
+    Movable& operator=(Movable&& other) noexcept(NoexceptMove) {
+        value = std::move(other.value);
+        return *this;
+    }
+};
+
+template<typename T> using NoexceptMove = Movable<T, true>;
+template<typename T> using ThrowingMove = Movable<T, false>;
+
+static_assert(std::is_nothrow_move_constructible_v<NoexceptMove<Point>>);
+static_assert(!std::is_nothrow_move_constructible_v<ThrowingMove<Point>>);
+static_assert(!std::is_trivially_copyable_v<NoexceptMove<Point>>);
+
+// Opaque callees (callees.cpp): the caller's translation unit cannot see that they
+// never throw, so only the declaration decides whether a call needs a landing pad
+int prfct_callee_may_throw(int value);
+int prfct_callee_noexcept(int value) noexcept;
@@ -1,78 +1,200 @@
-#include <random>
-#include <benchmark/benchmark.h>
+#include "common.h"
 
-static char random_data[1024*1024];
+// Elements per vector of the growth benchmarks
+static constexpr int GROWTH_SIZES[] = {1024, 64 * 1024};
 
-void initialize_random_data() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 255);
-    
-    for (size_t i = 0; i < sizeof(random_data); ++i) {
-        random_data[i] = static_cast<char>(dis(gen));
+// Assignments / calls per iteration of the variant, optional and call-site benchmarks
+static constexpr size_t BATCH = 1024;
+
+// ========== VECTOR GROWTH ==========
+// push_back without reserve: every reallocation relocates the existing elements with
+// std::move_if_noexcept, i.e. copies them unless the move constructor is noexcept
+
+template<typename Element>
+NOINLINE void prfct_grow(std::vector<Element>& vec, int count) {
+    for (int i = 0; i < count; ++i) {
+        vec.push_back(Element(i));
     }
 }
 
-// Pure virtual interface
-class Swapper {
-public:
-    virtual ~Swapper() = default;
-    virtual void prfct_swap(char& a, char& b) = 0;
-};
+template<typename Element>
+static void BM_growth(benchmark::State& state, int count) {
+    for (auto _ : state) {
+        std::vector<Element> vec;
+        prfct_grow(vec, count);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
 
-// Implementation with noexcept
-class NoExceptSwapper : public Swapper {
-public:
-    virtual void prfct_swap(char& a, char& b) noexcept override {
-        std::swap(a, b);
+// std::optional propagates the element's noexcept to its own move constructor, so the
+// optional gets the same treatment when it is the vector's element
+template<typename Element>
+NOINLINE void prfct_grow_optional(std::vector<std::optional<Element>>& vec, int count) {
+    for (int i = 0; i < count; ++i) {
+        vec.push_back(Element(i));
     }
-};
+}
 
-// Implementation without noexcept
-class RegularSwapper : public Swapper {
-public:
-    virtual void prfct_swap(char& a, char& b) override {
-        std::swap(a, b);
+template<typename Element>
+static void BM_growth_optional(benchmark::State& state, int count) {
+    for (auto _ : state) {
+        std::vector<std::optional<Element>> vec;
+        prfct_grow_optional(vec, count);
+        benchmark::DoNotOptimize(vec.data());
     }
-};
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
 
-void prfct_process_data_noexcept() {
-    NoExceptSwapper impl;
-    Swapper* swapper = &impl;
-    size_t size = sizeof(random_data);
-    for (size_t i = 0; i < size / 2; ++i) {
-        swapper->prfct_swap(random_data[i], random_data[size - 1 - i]);
+// ========== VARIANT / OPTIONAL ASSIGNMENT ==========
+// Copy-assigning a variant that holds another alternative: with a throwing copy but a
+// noexcept move, libstdc++ copies into a temporary variant and moves it in (the old
+// value is only destroyed once nothing can throw); otherwise it destroys the old
+// alternative and copies in place. Here noexcept adds a move.
+
+template<typename Element>
+NOINLINE void prfct_variant_copy_assign(std::variant<std::monostate, Element>& target,
+                                        const std::vector<std::variant<std::monostate, Element>>& sources) {
+    for (const auto& source : sources) {
+        target = std::monostate{};
+        target = source;
+        benchmark::DoNotOptimize(target);
+    }
+}
+
+template<typename Element>
+static void BM_variant_copy_assign(benchmark::State& state) {
+    std::vector<std::variant<std::monostate, Element>> sources;
+    for (size_t i = 0; i < BATCH; ++i) {
+        sources.emplace_back(Element(static_cast<int>(i)));
+    }
+    std::variant<std::monostate, Element> target;
+
+    for (auto _ : state) {
+        prfct_variant_copy_assign(target, sources);
     }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(BATCH));
 }
 
-void prfct_process_data_regular() {
-    RegularSwapper impl;
-    Swapper* swapper = &impl;
-    size_t size = sizeof(random_data);
-    for (size_t i = 0; i < size / 2; ++i) {
-        swapper->prfct_swap(random_data[i], random_data[size - 1 - i]);
+// Control: std::optional assignment has no exception-safety branch, both variants of
+// the element must run the same code
+template<typename Element>
+NOINLINE void prfct_optional_copy_assign(std::optional<Element>& target,
+                                         const std::vector<std::optional<Element>>& sources) {
+    for (const auto& source : sources) {
+        target.reset();
+        target = source;
+        benchmark::DoNotOptimize(target);
     }
 }
 
-static void BM_noexcept(benchmark::State& state) {
-    initialize_random_data();
-    
+template<typename Element>
+static void BM_optional_copy_assign(benchmark::State& state) {
+    std::vector<std::optional<Element>> sources;
+    for (size_t i = 0; i < BATCH; ++i) {
+        sources.emplace_back(Element(static_cast<int>(i)));
+    }
+    std::optional<Element> target;
+
     for (auto _ : state) {
-        prfct_process_data_noexcept();
-        benchmark::DoNotOptimize(random_data);
+        prfct_optional_copy_assign(target, sources);
     }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(BATCH));
 }
 
-static void BM_regular(benchmark::State& state) {
-    initialize_random_data();
-    
+// ========== CALL SITES ==========
+// The same loop calling an opaque function with a live object that has a destructor.
+// A callee that may throw needs a landing pad (run ~Guard, resume unwinding) and an
+// unwind table entry; a noexcept callee needs neither. A noexcept caller around a
+// callee that may throw gets a terminate entry instead. The hot path is identical,
+// compare the disassembly (landing pads, .text.unlikely) and code size.
+
+struct Guard {
+    int& cleanups;
+    ~Guard() { ++cleanups; }
+};
+
+NOINLINE int prfct_call_may_throw(const std::vector<int>& input) {
+    int sum = 0;
+    int cleanups = 0;
+    for (int value : input) {
+        Guard guard{cleanups};
+        sum += prfct_callee_may_throw(value);
+    }
+    return sum + cleanups;
+}
+
+NOINLINE int prfct_call_noexcept(const std::vector<int>& input) {
+    int sum = 0;
+    int cleanups = 0;
+    for (int value : input) {
+        Guard guard{cleanups};
+        sum += prfct_callee_noexcept(value);
+    }
+    return sum + cleanups;
+}
+
+NOINLINE int prfct_call_noexcept_caller(const std::vector<int>& input) noexcept {
+    int sum = 0;
+    int cleanups = 0;
+    for (int value : input) {
+        Guard guard{cleanups};
+        sum += prfct_callee_may_throw(value);
+    }
+    return sum + cleanups;
+}
+
+static void BM_call(benchmark::State& state, int (*caller)(const std::vector<int>&)) {
+    std::vector<int> input(BATCH);
+    for (size_t i = 0; i < BATCH; ++i) {
+        input[i] = static_cast<int>(i);
+    }
+
     for (auto _ : state) {
-        prfct_process_data_regular();
-        benchmark::DoNotOptimize(random_data);
+        benchmark::DoNotOptimize(caller(input));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(BATCH));
+}
+
+// =============================================================================
+// Registration
+// =============================================================================
+// Names: <Operation>/<Element>[_<N>]/<Noexcept|Throwing>, one summary table per
+// operation, element and size comparing the two move constructors
+
+template<typename T>
+static void register_element() {
+    std::string element = ElementName<T>::name;
+    for (int count : GROWTH_SIZES) {
+        std::string group = element + "_" + std::to_string(count / 1024) + "K/";
+        benchmark::RegisterBenchmark(("Growth/" + group + "Noexcept").c_str(), BM_growth<NoexceptMove<T>>, count);
+        benchmark::RegisterBenchmark(("Growth/" + group + "Throwing").c_str(), BM_growth<ThrowingMove<T>>, count);
+        benchmark::RegisterBenchmark(("GrowthOptional/" + group + "Noexcept").c_str(),
+                                     BM_growth_optional<NoexceptMove<T>>, count);
+        benchmark::RegisterBenchmark(("GrowthOptional/" + group + "Throwing").c_str(),
+                                     BM_growth_optional<ThrowingMove<T>>, count);
     }
+    benchmark::RegisterBenchmark(("VariantCopyAssign/" + element + "/Noexcept").c_str(),
+                                 BM_variant_copy_assign<NoexceptMove<T>>);
+    benchmark::RegisterBenchmark(("VariantCopyAssign/" + element + "/Throwing").c_str(),
+                                 BM_variant_copy_assign<ThrowingMove<T>>);
+    benchmark::RegisterBenchmark(("OptionalCopyAssign/" + element + "/Noexcept").c_str(),
+                                 BM_optional_copy_assign<NoexceptMove<T>>);
+    benchmark::RegisterBenchmark(("OptionalCopyAssign/" + element + "/Throwing").c_str(),
+                                 BM_optional_copy_assign<ThrowingMove<T>>);
+}
+
+static bool register_all() {
+    register_element<Point>();
+    register_element<LargeStruct>();
+    register_element<HeapString>();
+
+    benchmark::RegisterBenchmark("Call/Guard/MayThrow", BM_call, prfct_call_may_throw);
+    benchmark::RegisterBenchmark("Call/Guard/Noexcept", BM_call, prfct_call_noexcept);
+    benchmark::RegisterBenchmark("Call/Guard/NoexceptCaller", BM_call, prfct_call_noexcept_caller);
+    return true;
 }
 
-BENCHMARK(BM_noexcept);
-BENCHMARK(BM_regular);
+static const bool registered = register_all();
 
 BENCHMARK_MAIN();
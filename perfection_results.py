@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+"""
+Structured benchmark results store.
+
+benchmarks.sh writes one Google Benchmark JSON file per binary and configuration:
+    .benchmarks/<project>/runs/<compiler>_<opt_level>/<binary>.json
+or, with PERFECTION_REPETITIONS=N, one file per repetition:
+    .benchmarks/<project>/runs/<compiler>_<opt_level>/<binary>.rep<k>.json
+
+`merge` flattens every run of every project into one store:
+    .benchmarks/results.json
+
+Each record is one benchmark result with its configuration metadata
+(compiler, version, opt level, CPU, governor, commit). Times are in ns.
+Repeated runs give several records per benchmark; summarize() turns them
+into median, MAD and a 95% confidence interval with outliers rejected.
+compare_results.py diffs a store against a saved baseline (see mann_whitney_u()).
+
+Usage:
+    python3 perfection_results.py merge [benchmarks_dir]
+"""
+
+import json
+import math
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+
+STORE_NAME = "results.json"
+
+# Google Benchmark time units -> nanoseconds
+TIME_UNITS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+# Per-benchmark JSON keys that are not user or hardware counters
+BENCHMARK_KEYS = {
+    'name', 'family_index', 'per_family_instance_index', 'run_name', 'run_type',
+    'repetitions', 'repetition_index', 'threads', 'iterations', 'real_time',
+    'cpu_time', 'time_unit', 'label', 'error_occurred', 'error_message',
+    'aggregate_name', 'aggregate_unit',
+}
+
+# Samples further than this many scaled MADs from the median are outliers
+OUTLIER_MADS = 3.0
+
+# Scales the MAD to estimate the standard deviation of normally distributed samples
+MAD_TO_SIGMA = 1.4826
+
+# Context keys passed by benchmarks.sh through --benchmark_context
+CONTEXT_KEYS = ['config', 'compiler', 'compiler_version', 'opt_level', 'profile', 'cpu', 'governor', 'commit']
+
+
+def load_run(run_path: Path, project: str) -> List[Dict]:
+    """
+    Load one Google Benchmark JSON file and flatten it into store records.
+    
+    Aggregates (mean/median/stddev) and failed benchmarks are skipped.
+    """
+    with open(run_path, 'r') as f:
+        run = json.load(f)
+    
+    context = run.get('context', {})
+    # Fall back to the directory layout for runs without context metadata
+    config = context.get('config', run_path.parent.name)
+    
+    records = []
+    for bench in run.get('benchmarks', []):
+        if bench.get('run_type') == 'aggregate' or bench.get('error_occurred'):
+            continue
+        
+        scale = TIME_UNITS[bench.get('time_unit', 'ns')]
+        binary, _, repetition = run_path.stem.partition('.rep')
+        record = {
+            'project': project,
+            'binary': binary,
+            'repetition': int(repetition or 0) + bench.get('repetition_index', 0),
+            'benchmark': bench['name'],
+            'cpu_time_ns': bench['cpu_time'] * scale,
+            'real_time_ns': bench['real_time'] * scale,
+            'iterations': bench['iterations'],
+            'date': context.get('date'),
+            'host': context.get('host_name'),
+        }
+        for key in CONTEXT_KEYS:
+            record[key] = context.get(key)
+        record['config'] = config
+        if 'label' in bench:
+            record['label'] = bench['label']
+        record['counters'] = {
+            key: value for key, value in bench.items()
+            if key not in BENCHMARK_KEYS and isinstance(value, (int, float))
+        }
+        records.append(record)
+    
+    return records
+
+
+def collect_runs(benchmarks_dir: Path) -> List[Dict]:
+    """Load all runs of all projects below benchmarks_dir."""
+    records = []
+    for run_path in sorted(benchmarks_dir.glob('*/runs/*/*.json')):
+        project = run_path.parent.parent.parent.name
+        records.extend(load_run(run_path, project))
+    return records
+
+
+def merge(benchmarks_dir: Path) -> Path:
+    """Rebuild the merged store from all per-run JSON files."""
+    records = collect_runs(benchmarks_dir)
+    store_path = benchmarks_dir / STORE_NAME
+    with open(store_path, 'w') as f:
+        json.dump({'records': records}, f, indent=1)
+    return store_path
+
+
+def load_store(store_path: Path, project: Optional[str] = None) -> List[Dict]:
+    """Load records from a merged store, optionally for one project only."""
+    with open(store_path, 'r') as f:
+        records = json.load(f)['records']
+    if project is not None:
+        records = [r for r in records if r['project'] == project]
+    return records
+
+
+def median(values: List[float]) -> float:
+    """Median of a non-empty list."""
+    ordered = sorted(values)
+    mid = len(ordered) // 2
+    return ordered[mid] if len(ordered) % 2 else (ordered[mid - 1] + ordered[mid]) / 2
+
+
+def mad(values: List[float]) -> float:
+    """Median absolute deviation (unscaled)."""
+    center = median(values)
+    return median([abs(v - center) for v in values])
+
+
+def median_ci(values: List[float], confidence: float = 0.95) -> Tuple[float, float]:
+    """
+    Distribution-free confidence interval for the median from order statistics.
+
+    Picks the narrowest symmetric pair of order statistics whose binomial coverage
+    reaches `confidence`. Below 6 samples no pair does, so the full range is returned.
+    """
+    ordered = sorted(values)
+    n = len(ordered)
+    # P(lower < median < upper) for order statistics (k, n-1-k) is 1 - 2 * P(Bin(n, 0.5) <= k)
+    k = -1
+    tail = 0.0
+    while True:
+        next_tail = tail + math.comb(n, k + 1) / 2 ** n
+        if k + 1 >= n // 2 or 1 - 2 * next_tail < confidence:
+            break
+        tail = next_tail
+        k += 1
+    k = max(k, 0)
+    return ordered[k], ordered[n - 1 - k]
+
+
+def summarize(values: List[float]) -> Dict:
+    """
+    Robust statistics of repeated measurements.
+
+    Samples more than OUTLIER_MADS scaled MADs from the median are flagged as outliers
+    and excluded from the median, MAD and confidence interval.
+
+    Returns: {'n', 'median', 'mad', 'ci_low', 'ci_high', 'outliers': [...]}
+    """
+    center = median(values)
+    spread = mad(values) * MAD_TO_SIGMA
+    if spread > 0:
+        inliers = [v for v in values if abs(v - center) <= OUTLIER_MADS * spread]
+        outliers = [v for v in values if abs(v - center) > OUTLIER_MADS * spread]
+    else:
+        inliers, outliers = list(values), []
+
+    ci_low, ci_high = median_ci(inliers)
+    return {
+        'n': len(values),
+        'median': median(inliers),
+        'mad': mad(inliers),
+        'ci_low': ci_low,
+        'ci_high': ci_high,
+        'outliers': outliers,
+    }
+
+
+def mann_whitney_u(a: List[float], b: List[float]) -> float:
+    """
+    Two-sided p-value of the Mann-Whitney U test (normal approximation, tie-corrected).
+    
+    Distribution-free: asks whether samples of `a` tend to be larger or smaller than
+    those of `b`. Returns 1.0 when either side has a single sample or all values are equal.
+    """
+    n1, n2 = len(a), len(b)
+    if n1 < 2 or n2 < 2:
+        return 1.0
+    
+    # Average ranks over ties
+    pooled = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        tied = j - i + 1
+        tie_term += tied ** 3 - tied
+        i = j + 1
+    
+    rank_sum_a = sum(rank for rank, (_, side) in zip(ranks, pooled) if side == 0)
+    u = rank_sum_a - n1 * (n1 + 1) / 2
+    n = n1 + n2
+    variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    # Continuity correction
+    z = max(abs(u - n1 * n2 / 2) - 0.5, 0) / math.sqrt(variance)
+    return math.erfc(z / math.sqrt(2))
+
+
+def measured_time_ns(record: Dict) -> float:
+    """
+    Time a benchmark is judged by: CPU time, or wall time for benchmarks registered with
+    UseRealTime()/UseManualTime() (named '.../real_time', '.../manual_time').
+    
+    Multithreaded benchmarks ('.../threads:<n>', n > 1) report CPU time summed over all
+    threads, so they use real time as well.
+    """
+    name_parts = record['benchmark'].split('/')
+    if 'real_time' in name_parts or 'manual_time' in name_parts:
+        return record['real_time_ns']
+    threads = [part[len('threads:'):] for part in name_parts if part.startswith('threads:')]
+    if threads and threads[0].isdigit() and int(threads[0]) > 1:
+        return record['real_time_ns']
+    return record['cpu_time_ns']
+
+
+def group_samples(records: List[Dict], key: Optional[str] = None) -> Dict[Tuple[str, str, str], List[float]]:
+    """Group repeated measurements: {(project, config, benchmark): [values...]} (default: measured_time_ns)."""
+    samples = {}
+    for record in records:
+        value = record[key] if key else measured_time_ns(record)
+        samples.setdefault((record['project'], record['config'], record['benchmark']), []).append(value)
+    return samples
+
+
+def main():
+    if len(sys.argv) < 2 or sys.argv[1] != 'merge':
+        print(f"Usage: {sys.argv[0]} merge [benchmarks_dir]")
+        sys.exit(1)
+    
+    benchmarks_dir = Path(sys.argv[2]) if len(sys.argv) > 2 else Path(__file__).parent / '.benchmarks'
+    if not benchmarks_dir.is_dir():
+        print(f"Error: Directory not found: {benchmarks_dir}")
+        sys.exit(1)
+    
+    store_path = merge(benchmarks_dir)
+    print(f"✓ Merged results: {store_path}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,197 @@
+#!/bin/bash
+
+# Profile-guided optimization of one project: instrument -> train -> rebuild, per compiler
+#
+# PGO (default): build at -O3 with -fprofile-generate, run the benchmarks once to collect
+# a profile, rebuild the same build directory with -fprofile-use. AutoFDO (--autofdo):
+# build at -O3 with debug info, sample the benchmarks with perf (LBR branch stacks),
+# convert the samples and rebuild with -fprofile-sample-use (clang) / -fauto-profile (gcc).
+#
+# The optimized binaries are benchmarked like benchmarks.sh does, as configuration
+# <compiler>_O3_pgo (or _O3_autofdo); generate_summary.py compares them against <compiler>_O3.
+# benchmarks.sh clears a project's runs, so run this script after it.
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+source "${SCRIPT_DIR}/build_common.sh"
+
+# Benchmark arguments of the training run (short: the profile needs coverage, not precision)
+PERFECTION_PGO_TRAIN_ARGS="${PERFECTION_PGO_TRAIN_ARGS:---benchmark_min_time=0.05}"
+
+# LLVM tools matching the clang in PATH
+LLVM_PROFDATA="${LLVM_PROFDATA:-llvm-profdata}"
+
+MODE="pgo"
+if [ "$1" = "--autofdo" ]; then
+    MODE="autofdo"
+    shift
+fi
+
+if [ $# -ne 1 ]; then
+    echo "Usage: $0 [--autofdo] <project_name>"
+    echo "Example: $0 branch_prediction"
+    exit 1
+fi
+
+PROJECT_NAME="$1"
+PROJECT_DIR="${SCRIPT_DIR}/${PROJECT_NAME}"
+BINARY_NAME=$(basename "${PROJECT_NAME}")
+SAFE_PROJECT_NAME="${PROJECT_NAME//\//_}"
+BENCHMARKS_DIR="${SCRIPT_DIR}/.benchmarks/${SAFE_PROJECT_NAME}"
+RUNS_DIR="${BENCHMARKS_DIR}/runs"
+OPT_LEVEL="O3_${MODE}"
+
+if [ ! -d "${PROJECT_DIR}" ]; then
+    echo "Error: Project directory ${PROJECT_DIR} does not exist"
+    exit 1
+fi
+
+# AutoFDO converts perf samples with create_llvm_prof (clang) or create_gcov (gcc)
+# from https://github.com/google/autofdo
+if [ "${MODE}" = "autofdo" ] && ! command -v perf > /dev/null 2>&1; then
+    echo "Error: AutoFDO needs perf (and create_llvm_prof / create_gcov)"
+    exit 1
+fi
+
+# Training runs use the project's cores (all PERFECTION_THREADED_CPUS for multithreaded projects)
+PROJECT_CPUS=$(project_bench_cpus "${PROJECT_NAME}")
+mkdir -p "${BENCHMARKS_DIR}"
+
+echo "============================================"
+echo "Profile-guided optimization for project: ${PROJECT_NAME}"
+echo "Mode: ${MODE}"
+echo "Compilers: ${COMPILERS[@]}"
+echo "Training arguments: ${PERFECTION_PGO_TRAIN_ARGS}"
+echo "============================================"
+echo ""
+
+# Instrumentation (or profiling) flags of phase 1 and the flags using the profile in phase 2
+# Usage: phase_flags <compiler> <generate|use> <profile_dir>
+phase_flags() {
+    local compiler="$1"
+    local phase="$2"
+    local profile_dir="$3"
+
+    case "${MODE}:${compiler}:${phase}" in
+        pgo:gcc:generate)   echo "-fprofile-generate=${profile_dir} -fprofile-update=atomic" ;;
+        pgo:gcc:use)        echo "-fprofile-use=${profile_dir} -fprofile-correction -Wno-missing-profile" ;;
+        pgo:clang:generate) echo "-fprofile-generate=${profile_dir}" ;;
+        pgo:clang:use)      echo "-fprofile-use=${profile_dir}/default.profdata -Wno-profile-instr-unprofiled" ;;
+        autofdo:gcc:generate)   echo "-g" ;;
+        autofdo:gcc:use)        echo "-g -fauto-profile=${profile_dir}/merged.afdo" ;;
+        autofdo:clang:generate) echo "-g -fdebug-info-for-profiling" ;;
+        autofdo:clang:use)      echo "-g -fdebug-info-for-profiling -fprofile-sample-use=${profile_dir}/merged.afdo" ;;
+    esac
+}
+
+# Run the training workload: every benchmark binary once (under perf for AutoFDO)
+# Usage: train <compiler> <build_dir> <profile_dir>
+train() {
+    local compiler="$1"
+    local build_dir="$2"
+    local profile_dir="$3"
+
+    local binary name
+    for binary in $(config_binaries "${build_dir}" "${BINARY_NAME}"); do
+        name=$(basename "${binary}")
+        echo "  training: ${name}"
+        if [ "${MODE}" = "pgo" ]; then
+            run_pinned "${PROJECT_CPUS}" "${binary}" ${PERFECTION_PGO_TRAIN_ARGS} > /dev/null 2>&1
+        else
+            run_pinned "${PROJECT_CPUS}" perf record -q -b -o "${profile_dir}/${name}.perf.data" -- \
+                "${binary}" ${PERFECTION_PGO_TRAIN_ARGS} > /dev/null 2>&1
+            if [ "${compiler}" = "clang" ]; then
+                create_llvm_prof --binary="${binary}" --profile="${profile_dir}/${name}.perf.data" \
+                    --out="${profile_dir}/${name}.afdo"
+            else
+                create_gcov --binary="${binary}" --profile="${profile_dir}/${name}.perf.data" \
+                    --gcov="${profile_dir}/${name}.afdo" -gcov_version=2
+            fi
+        fi
+    done
+}
+
+# Combine the training output into the single profile phase 2 reads
+# Usage: merge_profiles <compiler> <profile_dir>
+merge_profiles() {
+    local compiler="$1"
+    local profile_dir="$2"
+
+    case "${MODE}:${compiler}" in
+        pgo:clang)
+            "${LLVM_PROFDATA}" merge -output="${profile_dir}/default.profdata" "${profile_dir}"/*.profraw ;;
+        autofdo:clang)
+            "${LLVM_PROFDATA}" merge -sample -output="${profile_dir}/merged.afdo" "${profile_dir}"/*.afdo ;;
+        autofdo:gcc)
+            local profiles=("${profile_dir}"/*.afdo)
+            if [ ${#profiles[@]} -eq 1 ]; then
+                cp "${profiles[0]}" "${profile_dir}/merged.afdo"
+            else
+                profile_merger --output_file="${profile_dir}/merged.afdo" "${profiles[@]}"
+            fi
+            ;;
+        # gcc PGO: .gcda files next to the object paths, read back directly
+    esac
+}
+
+FAILED=0
+
+for compiler in "${COMPILERS[@]}"; do
+    BUILD_DIR=$(config_build_dir "${SCRIPT_DIR}" "${PROJECT_NAME}" "${compiler}" "${OPT_LEVEL}")
+    PROFILE_DIR="${BUILD_DIR}/profile"
+
+    echo "============================================"
+    echo "${compiler}: ${MODE} build of ${PROJECT_NAME}"
+    echo "============================================"
+
+    # Always a fresh profile; the build key does not cover profile data
+    rm -rf "${PROFILE_DIR}" "${BUILD_DIR}/${BUILD_KEY_FILE}"
+    mkdir -p "${PROFILE_DIR}"
+
+    # Both phases use the same build directory: gcc finds .gcda files by object path
+    echo "  phase 1: instrumented build"
+    if ! build_project "${PROJECT_DIR}" "${BUILD_DIR}" "${compiler}" "O3" \
+            "$(phase_flags "${compiler}" generate "${PROFILE_DIR}")" > "${BUILD_DIR}/build.log" 2>&1; then
+        echo "  ✗ build failed (see ${BUILD_DIR}/build.log)"
+        FAILED=$((FAILED + 1))
+        continue
+    fi
+
+    echo "  phase 2: training run"
+    train "${compiler}" "${BUILD_DIR}" "${PROFILE_DIR}"
+    merge_profiles "${compiler}" "${PROFILE_DIR}"
+
+    echo "  phase 3: optimized build"
+    if ! build_project "${PROJECT_DIR}" "${BUILD_DIR}" "${compiler}" "O3" \
+            "$(phase_flags "${compiler}" use "${PROFILE_DIR}")" >> "${BUILD_DIR}/build.log" 2>&1; then
+        echo "  ✗ build failed (see ${BUILD_DIR}/build.log)"
+        FAILED=$((FAILED + 1))
+        continue
+    fi
+    echo "  ✓ ${compiler}_${OPT_LEVEL}"
+    echo ""
+
+    # Benchmark the optimized binaries like benchmarks.sh (same runs/ layout and log)
+    for bench_binary in $(config_binaries "${BUILD_DIR}" "${BINARY_NAME}"); do
+        for rep in $(seq 1 "${PERFECTION_REPETITIONS}"); do
+            run_benchmark "${SCRIPT_DIR}" "${PROJECT_NAME}" "${compiler}" "${OPT_LEVEL}" "${bench_binary}" "${rep}"
+        done
+    done
+    echo ""
+done
+
+python3 "${SCRIPT_DIR}/perfection_results.py" merge "${SCRIPT_DIR}/.benchmarks"
+
+echo "============================================"
+if [ ${FAILED} -ne 0 ]; then
+    echo "Done with ${FAILED} failed compiler(s)"
+else
+    echo "Done! Results saved to: ${RUNS_DIR}/<compiler>_${OPT_LEVEL}/"
+fi
+echo "Compare against O3:"
+echo "  python3 ${SCRIPT_DIR}/generate_summary.py ${BENCHMARKS_DIR}"
+echo "============================================"
+if [ ${FAILED} -ne 0 ]; then
+    exit 1
+fi
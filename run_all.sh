@@ -3,8 +3,9 @@
 set -e
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+source "${SCRIPT_DIR}/build_common.sh"
 
-PROJECTS=("inlining" "virtual" "noexcept" "exception" "cache_locality" "branch_prediction" "ilp_no_data_dependencies" "ilp_data_dependencies")
+PROJECTS=("inlining" "virtual" "noexcept" "exception" "cache_locality" "branch_prediction" "ilp_no_data_dependencies" "ilp_data_dependencies" "memory_bandwidth" "soa_aos" "dispatch")
 
 echo "============================================"
 echo "Running all benchmarks and disassembly"
@@ -12,6 +13,11 @@ echo "Projects: ${PROJECTS[@]}"
 echo "============================================"
 echo ""
 
+# Build the whole matrix once, in parallel; benchmarks.sh and disassembly.sh
+# then reuse these builds instead of rebuilding each configuration
+build_matrix "${SCRIPT_DIR}" "${PROJECTS[@]}"
+export PERFECTION_SKIP_BUILD=1
+
 for project in "${PROJECTS[@]}"; do
     echo "============================================"
     echo "Processing project: ${project}"
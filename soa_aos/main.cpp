@@ -0,0 +1,290 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+// Particle counts: SMALL fits in L2 in every layout (192KB), LARGE streams from DRAM (96MB)
+static constexpr size_t SMALL = 4 * 1024;
+static constexpr size_t LARGE = 2 * 1024 * 1024;
+
+// Integration time step and squared radius of the distance filter (~6.5% of the particles)
+static constexpr double DT = 1e-3;
+static constexpr double RADIUS_SQUARED = 0.25;
+
+// ========== LAYOUTS ==========
+
+struct Point {
+    double x, y, z;
+};
+
+// AoS: one 48-byte record per particle; a kernel that needs one field still loads all six
+struct Particle {
+    Point position;
+    Point velocity;
+};
+using ParticlesAoS = std::vector<Particle>;
+
+// SoA: one array per field; kernels load only the fields they use, in unit-stride vectors
+struct ParticlesSoA {
+    std::vector<double> x, y, z, vx, vy, vz;
+};
+
+// AoSoA: blocks of B particles stored as SoA; unit-stride lanes like SoA, while one
+// particle's fields stay within one block (a few pages instead of six separate arrays)
+template <size_t B>
+struct alignas(64) ParticleBlock {
+    double x[B], y[B], z[B], vx[B], vy[B], vz[B];
+};
+template <size_t B>
+using ParticlesAoSoA = std::vector<ParticleBlock<B>>;
+
+// Positions and velocities uniform in [-1, 1], same values in every layout
+ParticlesAoS make_particles(size_t count) {
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    ParticlesAoS particles(count);
+    for (Particle& p : particles) {
+        p.position.x = dis(gen);
+        p.position.y = dis(gen);
+        p.position.z = dis(gen);
+        p.velocity.x = dis(gen);
+        p.velocity.y = dis(gen);
+        p.velocity.z = dis(gen);
+    }
+    return particles;
+}
+
+void convert(const ParticlesAoS& source, ParticlesAoS& target) {
+    target = source;
+}
+
+void convert(const ParticlesAoS& source, ParticlesSoA& target) {
+    for (const Particle& p : source) {
+        target.x.push_back(p.position.x);
+        target.y.push_back(p.position.y);
+        target.z.push_back(p.position.z);
+        target.vx.push_back(p.velocity.x);
+        target.vy.push_back(p.velocity.y);
+        target.vz.push_back(p.velocity.z);
+    }
+}
+
+// Particle counts are multiples of B, so every block is full
+template <size_t B>
+void convert(const ParticlesAoS& source, ParticlesAoSoA<B>& target) {
+    target.resize(source.size() / B);
+    for (size_t i = 0; i < source.size(); ++i) {
+        ParticleBlock<B>& block = target[i / B];
+        const size_t lane = i % B;
+        block.x[lane] = source[i].position.x;
+        block.y[lane] = source[i].position.y;
+        block.z[lane] = source[i].position.z;
+        block.vx[lane] = source[i].velocity.x;
+        block.vy[lane] = source[i].velocity.y;
+        block.vz[lane] = source[i].velocity.z;
+    }
+}
+
+// ========== POSITION INTEGRATION: read 6 fields, write 3 ==========
+
+void prfct_integrate_aos(ParticlesAoS& particles, double dt) {
+    for (Particle& p : particles) {
+        p.position.x += p.velocity.x * dt;
+        p.position.y += p.velocity.y * dt;
+        p.position.z += p.velocity.z * dt;
+    }
+}
+
+void prfct_integrate_soa(ParticlesSoA& particles, double dt) {
+    const size_t count = particles.x.size();
+    double* __restrict x = particles.x.data();
+    double* __restrict y = particles.y.data();
+    double* __restrict z = particles.z.data();
+    const double* __restrict vx = particles.vx.data();
+    const double* __restrict vy = particles.vy.data();
+    const double* __restrict vz = particles.vz.data();
+    for (size_t i = 0; i < count; ++i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        z[i] += vz[i] * dt;
+    }
+}
+
+template <size_t B>
+void prfct_integrate_aosoa(ParticlesAoSoA<B>& particles, double dt) {
+    for (ParticleBlock<B>& block : particles) {
+        for (size_t lane = 0; lane < B; ++lane) {
+            block.x[lane] += block.vx[lane] * dt;
+            block.y[lane] += block.vy[lane] * dt;
+            block.z[lane] += block.vz[lane] * dt;
+        }
+    }
+}
+
+// ========== DISTANCE FILTER: read 3 fields, count particles within the radius ==========
+
+size_t prfct_count_within_aos(const ParticlesAoS& particles, double radius_squared) {
+    size_t count = 0;
+    for (const Particle& p : particles) {
+        const double d = p.position.x * p.position.x + p.position.y * p.position.y + p.position.z * p.position.z;
+        count += d < radius_squared;
+    }
+    return count;
+}
+
+size_t prfct_count_within_soa(const ParticlesSoA& particles, double radius_squared) {
+    const size_t n = particles.x.size();
+    const double* x = particles.x.data();
+    const double* y = particles.y.data();
+    const double* z = particles.z.data();
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const double d = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+        count += d < radius_squared;
+    }
+    return count;
+}
+
+template <size_t B>
+size_t prfct_count_within_aosoa(const ParticlesAoSoA<B>& particles, double radius_squared) {
+    size_t count = 0;
+    for (const ParticleBlock<B>& block : particles) {
+        for (size_t lane = 0; lane < B; ++lane) {
+            const double d = block.x[lane] * block.x[lane] + block.y[lane] * block.y[lane] + block.z[lane] * block.z[lane];
+            count += d < radius_squared;
+        }
+    }
+    return count;
+}
+
+// ========== REDUCTION: read 3 fields, sum kinetic energy ==========
+// A single floating point accumulator is a dependency chain the compiler may not
+// reorder (no -ffast-math). Every layout therefore sums into the same REDUCE_LANES
+// independent accumulators, particle i into lanes[i % REDUCE_LANES], so the chains
+// have the same length everywhere and only the memory layout differs (the additions
+// also happen in the same order, so all layouts return the same value).
+
+// Accumulators per layout (particle counts are multiples of it)
+static constexpr size_t REDUCE_LANES = 8;
+
+// Fold the accumulators in lane order
+double sum_lanes(const double (&lanes)[REDUCE_LANES]) {
+    double energy = 0.0;
+    for (size_t lane = 0; lane < REDUCE_LANES; ++lane) {
+        energy += lanes[lane];
+    }
+    return energy;
+}
+
+double prfct_kinetic_energy_aos(const ParticlesAoS& particles) {
+    double lanes[REDUCE_LANES] = {};
+    for (size_t i = 0; i < particles.size(); i += REDUCE_LANES) {
+        for (size_t lane = 0; lane < REDUCE_LANES; ++lane) {
+            const Point& v = particles[i + lane].velocity;
+            lanes[lane] += 0.5 * (v.x * v.x + v.y * v.y + v.z * v.z);
+        }
+    }
+    return sum_lanes(lanes);
+}
+
+double prfct_kinetic_energy_soa(const ParticlesSoA& particles) {
+    const size_t n = particles.vx.size();
+    const double* vx = particles.vx.data();
+    const double* vy = particles.vy.data();
+    const double* vz = particles.vz.data();
+    double lanes[REDUCE_LANES] = {};
+    for (size_t i = 0; i < n; i += REDUCE_LANES) {
+        for (size_t lane = 0; lane < REDUCE_LANES; ++lane) {
+            lanes[lane] += 0.5 * (vx[i + lane] * vx[i + lane] + vy[i + lane] * vy[i + lane] + vz[i + lane] * vz[i + lane]);
+        }
+    }
+    return sum_lanes(lanes);
+}
+
+template <size_t B>
+double prfct_kinetic_energy_aosoa(const ParticlesAoSoA<B>& particles) {
+    static_assert(B % REDUCE_LANES == 0, "blocks must hold whole accumulator rows");
+    double lanes[REDUCE_LANES] = {};
+    for (const ParticleBlock<B>& block : particles) {
+        for (size_t row = 0; row < B; row += REDUCE_LANES) {
+            const double* vx = block.vx + row;
+            const double* vy = block.vy + row;
+            const double* vz = block.vz + row;
+            for (size_t lane = 0; lane < REDUCE_LANES; ++lane) {
+                lanes[lane] += 0.5 * (vx[lane] * vx[lane] + vy[lane] * vy[lane] + vz[lane] * vz[lane]);
+            }
+        }
+    }
+    return sum_lanes(lanes);
+}
+
+// Layout-independent entry points for the benchmark templates
+void integrate(ParticlesAoS& particles, double dt) { prfct_integrate_aos(particles, dt); }
+void integrate(ParticlesSoA& particles, double dt) { prfct_integrate_soa(particles, dt); }
+template <size_t B>
+void integrate(ParticlesAoSoA<B>& particles, double dt) { prfct_integrate_aosoa(particles, dt); }
+
+size_t count_within(const ParticlesAoS& particles, double r2) { return prfct_count_within_aos(particles, r2); }
+size_t count_within(const ParticlesSoA& particles, double r2) { return prfct_count_within_soa(particles, r2); }
+template <size_t B>
+size_t count_within(const ParticlesAoSoA<B>& particles, double r2) { return prfct_count_within_aosoa(particles, r2); }
+
+double kinetic_energy(const ParticlesAoS& particles) { return prfct_kinetic_energy_aos(particles); }
+double kinetic_energy(const ParticlesSoA& particles) { return prfct_kinetic_energy_soa(particles); }
+template <size_t B>
+double kinetic_energy(const ParticlesAoSoA<B>& particles) { return prfct_kinetic_energy_aosoa(particles); }
+
+// ========== BENCHMARKS ==========
+// items_per_second: particles processed per second
+
+template <typename Layout, size_t Count>
+static void BM_Integrate(benchmark::State& state) {
+    Layout particles;
+    convert(make_particles(Count), particles);
+
+    for (auto _ : state) {
+        integrate(particles, DT);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(Count));
+}
+
+template <typename Layout, size_t Count>
+static void BM_Filter(benchmark::State& state) {
+    Layout particles;
+    convert(make_particles(Count), particles);
+
+    for (auto _ : state) {
+        size_t result = count_within(particles, RADIUS_SQUARED);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(Count));
+}
+
+template <typename Layout, size_t Count>
+static void BM_Reduce(benchmark::State& state) {
+    Layout particles;
+    convert(make_particles(Count), particles);
+
+    for (auto _ : state) {
+        double result = kinetic_energy(particles);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(Count));
+}
+
+// Names: <Kernel>/<Particles>/<Layout>, grouped per kernel and size in summary.md
+#define PERFECTION_LAYOUT_BENCHMARKS(BM, Kernel, Count, Label)                                      \
+    BENCHMARK(BM<ParticlesAoS, Count>)->Name(Kernel "/" Label "/AoS");                               \
+    BENCHMARK(BM<ParticlesSoA, Count>)->Name(Kernel "/" Label "/SoA");                               \
+    BENCHMARK(BM<ParticlesAoSoA<8>, Count>)->Name(Kernel "/" Label "/AoSoA8");                       \
+    BENCHMARK(BM<ParticlesAoSoA<16>, Count>)->Name(Kernel "/" Label "/AoSoA16")
+
+PERFECTION_LAYOUT_BENCHMARKS(BM_Integrate, "Integrate", SMALL, "4K");
+PERFECTION_LAYOUT_BENCHMARKS(BM_Integrate, "Integrate", LARGE, "2M");
+PERFECTION_LAYOUT_BENCHMARKS(BM_Filter, "Filter", SMALL, "4K");
+PERFECTION_LAYOUT_BENCHMARKS(BM_Filter, "Filter", LARGE, "2M");
+PERFECTION_LAYOUT_BENCHMARKS(BM_Reduce, "Reduce", SMALL, "4K");
+PERFECTION_LAYOUT_BENCHMARKS(BM_Reduce, "Reduce", LARGE, "2M");
+
+BENCHMARK_MAIN();